@@ -0,0 +1,202 @@
+#include "Analysis.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include "Board.h"
+#include "Nnue.h"
+
+namespace {
+
+std::string colorName(int color) { return color == 0 ? "Light" : "Dark"; }
+
+void printTree(const GameTree& tree, int id, int indent) {
+    for (;;) {
+        const GameTree::Node& node = tree.node(id);
+        if (node.children.empty()) return;
+        for (std::size_t i = 0; i < node.children.size(); ++i) {
+            const GameTree::Node& child = tree.node(node.children[i]);
+            std::cout << std::string(indent, ' ') << (child.ply + 1) / 2 << (child.ply % 2 ? ". " : "... ")
+                      << child.move.toString() << "  [" << node.children[i] << "]"
+                      << (node.children[i] == tree.current() ? "  <" : "") << '\n';
+            if (i > 0) printTree(tree, node.children[i], indent + 4);
+        }
+        id = node.children[0];
+    }
+}
+
+}
+
+Analyzer::Analyzer(int lines, std::size_t ttEntries) : engine_(ttEntries), lines_(std::max(1, lines)), stop_(false) {}
+
+Analyzer::~Analyzer() { stop(); }
+
+void Analyzer::setNetwork(std::shared_ptr<const Nnue> network) {
+    stop();
+    engine_.setNetwork(std::move(network));
+}
+
+void Analyzer::setLines(int lines) {
+    stop();
+    lines_ = std::max(1, lines);
+}
+
+void Analyzer::analyze(const Position& position) {
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_ = Snapshot();
+        snapshot_.position = position;
+    }
+    stop_ = false;
+    start_ = std::chrono::steady_clock::now();
+    thread_ = std::thread([this, position] {
+        auto publish = [this](const std::vector<SearchResult>& lines) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            std::lock_guard<std::mutex> lock(mutex_);
+            snapshot_.lines = lines;
+            snapshot_.elapsedMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+        };
+        const SearchLimits limits(Engine::MAX_PLY, 0, 0, &stop_);
+        std::vector<SearchResult> lines = engine_.searchMultiPv(position, limits, lines_, publish);
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_.lines = lines;
+        snapshot_.finished = true;
+    });
+}
+
+void Analyzer::stop() {
+    if (!thread_.joinable()) return;
+    stop_ = true;
+    thread_.join();
+}
+
+Analyzer::Snapshot Analyzer::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return snapshot_;
+}
+
+AnalysisBoard::AnalysisBoard(const Position& start) : tree_(start) {
+    try {
+        std::shared_ptr<Nnue> network = std::make_shared<Nnue>();
+        if (network->load(Nnue::DEFAULT_FILE)) analyzer_.setNetwork(network);
+    } catch (const std::exception& e) {
+        std::cout << "Warning: " << e.what() << ", using the classic evaluation.\n";
+    }
+}
+
+void AnalysisBoard::run() {
+    analyzer_.analyze(tree_.position());
+    display();
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty()) continue;
+        if (!handleCommand(line)) break;
+    }
+    analyzer_.stop();
+}
+
+bool AnalysisBoard::handleCommand(const std::string& line) {
+    std::istringstream in(line);
+    std::string command;
+    in >> command;
+    int argument = -1;
+    bool hasArgument = static_cast<bool>(in >> argument);
+
+    try {
+        if (command == "exit") {
+            analyzer_.stop();
+            std::exit(0);
+        } else if (command == "q") {
+            return false;
+        } else if (command == "b") {
+            if (tree_.back()) moved();
+            else std::cout << "Already at the start.\n";
+        } else if (command == "f") {
+            if (tree_.forward(hasArgument ? argument : 0)) moved();
+            else std::cout << "No such continuation.\n";
+        } else if (command == "j" && hasArgument) {
+            tree_.jump(argument);
+            moved();
+        } else if (command == "p") {
+            tree_.promote();
+            std::cout << "Variation promoted to the main line.\n";
+        } else if (command == "t") {
+            printTree(tree_, 0, 0);
+        } else if (command == "a") {
+            showLines();
+        } else if (command == "l" && hasArgument) {
+            analyzer_.setLines(argument);
+            analyzer_.analyze(tree_.position());
+            std::cout << "Showing " << analyzer_.lines() << " lines.\n";
+        } else if (command == "g") {
+            Analyzer::Snapshot snapshot = analyzer_.snapshot();
+            int index = hasArgument ? argument - 1 : 0;
+            if (index < 0 || index >= static_cast<int>(snapshot.lines.size())) {
+                std::cout << "No such line yet.\n";
+            } else {
+                tree_.play(snapshot.lines[index].bestMove);
+                moved();
+            }
+        } else {
+            tree_.play(Move::fromString(command));
+            moved();
+        }
+    } catch (const std::exception& e) {
+        std::cout << e.what() << '\n';
+    }
+    return true;
+}
+
+void AnalysisBoard::moved() {
+    analyzer_.analyze(tree_.position());
+    display();
+}
+
+void AnalysisBoard::display() const {
+    const Position& position = tree_.position();
+    Board board;
+    for (int pos = 0; pos < Position::NUM_POINTS; ++pos) {
+        if (position.pieceAt(pos) >= 0) board.tryPlacePiece<UncheckedPolicy>(position.pieceAt(pos), pos);
+    }
+    board.displayBoardWithReference();
+
+    const GameTree::Node& node = tree_.node(tree_.current());
+    std::cout << "Node " << tree_.current() << ", ply " << node.ply << ", " << colorName(position.sideToMove())
+              << " to move, in hand " << position.piecesInHand(0) << "/" << position.piecesInHand(1) << "\n";
+    std::cout << "Line:";
+    for (const Move& move : tree_.line(tree_.current())) std::cout << ' ' << move.toString();
+    std::cout << '\n';
+    if (!node.children.empty()) {
+        std::cout << "Continuations:";
+        for (std::size_t i = 0; i < node.children.size(); ++i) {
+            std::cout << "  f " << i << " = " << tree_.node(node.children[i]).move.toString();
+        }
+        std::cout << '\n';
+    }
+    if (position.isLost()) std::cout << colorName(1 - position.sideToMove()) << " has won.\n";
+
+    std::cout << "\nMove (e.g. 7, 7-8, 7x3), b back, f [n] forward, j ID jump, t tree, p promote variation,\n"
+                 "a analysis, g [k] play line k, l K show K lines, q menu\n";
+}
+
+void AnalysisBoard::showLines() const {
+    Analyzer::Snapshot snapshot = analyzer_.snapshot();
+    if (snapshot.position.isGameOver()) {
+        std::cout << "Game over, nothing to analyze.\n";
+        return;
+    }
+    if (snapshot.lines.empty()) {
+        std::cout << "Analysis is starting, try again in a moment.\n";
+        return;
+    }
+    std::cout << "Depth " << snapshot.lines.front().depth << (snapshot.finished ? " (done)" : "") << ", "
+              << snapshot.lines.front().nodes << " nodes, " << snapshot.elapsedMs << " ms, scores for "
+              << colorName(snapshot.position.sideToMove()) << '\n';
+    for (std::size_t i = 0; i < snapshot.lines.size(); ++i) {
+        const SearchResult& line = snapshot.lines[i];
+        std::cout << i + 1 << ". " << Engine::formatScore(line.score) << "  ";
+        for (const Move& move : line.pv) std::cout << ' ' << move.toString();
+        std::cout << '\n';
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Engine.h"
+#include "GameTree.h"
+
+// Keeps a multi-PV search running on a background thread for the position being browsed.
+// The engine lives as long as the analyzer, so its transposition table carries over when
+// the user goes back or switches to another variation.
+class Analyzer {
+public:
+    struct Snapshot {
+        Position position;
+        std::vector<SearchResult> lines;
+        int elapsedMs = 0;
+        bool finished = false;
+    };
+
+    explicit Analyzer(int lines = 3, std::size_t ttEntries = 1 << 22);
+    ~Analyzer();
+
+    void setNetwork(std::shared_ptr<const Nnue> network);
+    void setLines(int lines);
+    int lines() const { return lines_; }
+    // Stops the running search and starts one on position.
+    void analyze(const Position& position);
+    void stop();
+    Snapshot snapshot() const;
+
+private:
+    Engine engine_;
+    int lines_;
+    std::thread thread_;
+    std::atomic<bool> stop_;
+    mutable std::mutex mutex_;
+    Snapshot snapshot_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Console analysis board: enter moves to build a game tree, step through it and branch
+// anywhere while the analyzer follows the current node.
+class AnalysisBoard {
+public:
+    explicit AnalysisBoard(const Position& start = Position());
+    void run();
+
+private:
+    GameTree tree_;
+    Analyzer analyzer_;
+
+    void display() const;
+    void showLines() const;
+    void showTree() const;
+    bool handleCommand(const std::string& line);
+    void moved();
+};
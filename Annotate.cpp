@@ -0,0 +1,196 @@
+#include "BoundedQueue.h"
+#include "Engine.h"
+#include "Position.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Streams game records (one game per line, moves in Move::toString() notation)
+// through parse -> search -> ordered write. A window of in-flight games bounds
+// every queue and the writer's reorder buffer, so memory does not grow with input size.
+
+namespace {
+
+struct Options {
+    std::string input;
+    std::string output;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t window = 64;
+    SearchLimits limits = SearchLimits(32, 20000);
+};
+
+struct GameJob {
+    std::size_t index = 0;
+    std::size_t line = 0;
+    std::vector<Move> moves;
+    std::string error;
+    std::vector<SearchResult> results;   // one per position, including the final one
+};
+
+GameJob parseGame(const std::string& text, std::size_t index, std::size_t line) {
+    GameJob job;
+    job.index = index;
+    job.line = line;
+
+    std::istringstream in(text);
+    std::string token;
+    Position pos;
+    while (in >> token) {
+        Move move;
+        try {
+            move = Move::fromString(token);
+        } catch (const std::exception& e) {
+            job.error = e.what();
+            break;
+        }
+        if (pos.isLost() || !pos.isLegal(move)) {
+            job.error = "illegal move '" + token + "' at ply " + std::to_string(job.moves.size() + 1);
+            break;
+        }
+        pos.makeMove(move);
+        job.moves.push_back(move);
+    }
+    if (!job.error.empty()) job.moves.clear();
+    return job;
+}
+
+void annotateGame(Engine& engine, const SearchLimits& limits, GameJob& job) {
+    if (!job.error.empty()) return;
+    engine.clear();
+    Position pos;
+    job.results.reserve(job.moves.size() + 1);
+    for (std::size_t ply = 0; ply <= job.moves.size(); ++ply) {
+        job.results.push_back(engine.search(pos, limits));
+        if (ply < job.moves.size()) pos.makeMove(job.moves[ply]);
+    }
+}
+
+// A child's score seen from its parent, one ply further from any forced result.
+int parentScore(int childScore) {
+    int score = -childScore;
+    if (score >= Engine::SCORE_WIN_THRESHOLD) return score - 1;
+    if (score <= -Engine::SCORE_WIN_THRESHOLD) return score + 1;
+    return score;
+}
+
+void writeGame(std::ostream& out, const GameJob& job) {
+    if (!job.error.empty()) {
+        out << "# game " << job.index + 1 << " (line " << job.line << "): " << job.error << "\n";
+        return;
+    }
+    for (std::size_t ply = 0; ply < job.moves.size(); ++ply) {
+        const SearchResult& before = job.results[ply];
+        int played = parentScore(job.results[ply + 1].score);
+        int error = std::max(0, before.score - played);
+        if (Engine::isWinScore(before.score) || Engine::isWinScore(played)) {
+            error = (before.score > 0) == (played > 0) ? 0 : Engine::SCORE_WIN;
+        }
+        out << job.index + 1 << '\t' << ply + 1 << '\t' << (ply % 2 == 0 ? 'O' : 'X') << '\t'
+            << job.moves[ply].toString() << '\t' << before.bestMove.toString() << '\t'
+            << Engine::formatScore(before.score) << '\t' << Engine::formatScore(played) << '\t' << error << '\n';
+    }
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue) options.output = argv[++i];
+        else if (arg == "--threads" && hasValue) options.threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--window" && hasValue) options.window = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--nodes" && hasValue) options.limits.nodes = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--depth" && hasValue) options.limits.depth = std::max(1, std::atoi(argv[++i]));
+        else if (options.input.empty() && arg[0] != '-') options.input = arg;
+        else return false;
+    }
+    return !options.input.empty();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: annotate <games.txt> [--output FILE] [--threads N] [--nodes N] [--depth N] [--window N]\n";
+        return 1;
+    }
+
+    std::ifstream input(options.input);
+    if (!input) {
+        std::cerr << "Error: cannot open " << options.input << "\n";
+        return 1;
+    }
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Error: cannot write " << options.output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+
+    const auto start = std::chrono::steady_clock::now();
+    InFlightWindow window(options.window);
+    BoundedQueue<GameJob> parsed(options.window);
+    BoundedQueue<GameJob> annotated(options.window);
+
+    std::thread parser([&] {
+        std::string line;
+        std::size_t lineNumber = 0, index = 0;
+        while (std::getline(input, line)) {
+            ++lineNumber;
+            if (line.empty() || line[0] == '#') continue;
+            window.acquire(index);
+            parsed.push(parseGame(line, index++, lineNumber));
+        }
+        parsed.close();
+    });
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < options.threads; ++i) {
+        workers.emplace_back([&] {
+            Engine engine(1 << 16);
+            GameJob job;
+            while (parsed.pop(job)) {
+                annotateGame(engine, options.limits, job);
+                annotated.push(std::move(job));
+            }
+        });
+    }
+
+    std::size_t games = 0, positions = 0;
+    std::thread writer([&] {
+        out << "game\tply\tplayer\tmove\tbest\teval\tplayed\terror\n";
+        std::map<std::size_t, GameJob> pending;
+        GameJob job;
+        while (annotated.pop(job)) {
+            pending.insert(std::make_pair(job.index, std::move(job)));
+            for (auto it = pending.find(games); it != pending.end(); it = pending.find(games)) {
+                writeGame(out, it->second);
+                positions += it->second.results.size();
+                pending.erase(it);
+                ++games;
+                window.release();
+            }
+        }
+        out.flush();
+    });
+
+    parser.join();
+    for (auto& worker : workers) worker.join();
+    annotated.close();
+    writer.join();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cerr << "Annotated " << games << " games (" << positions << " positions) in "
+              << elapsed.count() << " ms using " << options.threads << " threads\n";
+    return 0;
+}
@@ -0,0 +1,336 @@
+#include "Board.h"
+#include "Player.h"
+#include "Position.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Microbenchmarks for the Board and Player operations the game runs every move,
+// plus whole-game replays, over seeded corpora so runs are comparable. Results are
+// tab-separated (ns/op, allocations/op) and can be checked against a baseline file.
+
+namespace {
+
+uint64_t allocations = 0;
+
+}
+
+// Counting hook: every global allocation in this program goes through here.
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept { operator delete[](p); }
+
+namespace {
+
+struct Options {
+    std::string output;
+    std::string baseline;
+    std::string filter;
+    double threshold = 10.0;   // percent
+    int minMs = 200;
+    unsigned seed = 1;
+    int fixtures = 256;
+    int games = 64;
+};
+
+struct Result {
+    std::string name;
+    double nsPerOp = 0;
+    double allocsPerOp = 0;
+    uint64_t ops = 0;
+};
+
+// The game's own objects after replaying part of a game. Pieces point back at their
+// Player and Spots at Pieces, so fixtures are built in place and never copied.
+struct Fixture {
+    Board board;
+    Player players[2];
+
+    Fixture() : players{Player("Player 1", 0), Player("Player 2", 1)} {}
+    Fixture(const Fixture&) = delete;
+    Fixture& operator=(const Fixture&) = delete;
+};
+
+// Applies a move generated by Position to the game's objects. The move is legal, so the
+// Board calls skip validation and only the state changes are replayed.
+void applyMove(Fixture& fixture, const Move& move, int color) {
+    Board& board = fixture.board;
+    if (move.isPlacement()) {
+        fixture.players[color].placePiece(board.getSpot<UncheckedPolicy>(move.to));
+        board.tryPlacePiece<UncheckedPolicy>(color, move.to);
+    } else {
+        board.tryMovePiece<UncheckedPolicy>(move.from, move.to);
+    }
+    if (board.isMillFormed(move.to, color) && move.isCapture()) {
+        Piece* target = board.getSpot<UncheckedPolicy>(move.remove)->getPiece();
+        if (target) fixture.players[1 - color].capturePiece(target);
+        board.tryRemovePiece<UncheckedPolicy>(move.remove);
+        fixture.players[color].incrementCaptured();
+    }
+}
+
+std::vector<Move> randomGame(std::mt19937& rng, int maxPlies) {
+    Position pos;
+    std::vector<Move> moves, game;
+    while (!pos.isGameOver() && static_cast<int>(game.size()) < maxPlies) {
+        pos.generateMoves(moves);
+        game.push_back(moves[rng() % moves.size()]);
+        pos.makeMove(game.back());
+    }
+    return game;
+}
+
+struct Corpus {
+    std::deque<Fixture> fixtures;
+    // Same positions for Board::isMillFormed, which updates the pieces' mill flags.
+    std::deque<Fixture> millFixtures;
+    std::vector<int> sideToMove;
+    std::vector<std::vector<Move>> games;
+    struct Query { int fixture, from, to, color; };
+    std::vector<Query> queries;
+};
+
+void buildCorpus(const Options& options, Corpus& corpus) {
+    std::mt19937 rng(options.seed);
+    for (int i = 0; i < options.fixtures; ++i) {
+        std::vector<Move> game = randomGame(rng, 10 + static_cast<int>(rng() % 60));
+        corpus.fixtures.emplace_back();
+        corpus.millFixtures.emplace_back();
+        for (std::size_t ply = 0; ply < game.size(); ++ply) {
+            applyMove(corpus.fixtures.back(), game[ply], ply % 2);
+            applyMove(corpus.millFixtures.back(), game[ply], ply % 2);
+        }
+        corpus.sideToMove.push_back(game.size() % 2);
+    }
+    for (int i = 0; i < options.games; ++i) corpus.games.push_back(randomGame(rng, 1000));
+
+    // Queries start from an occupied point where possible, so owned and empty cases both occur.
+    for (int i = 0; i < 4096; ++i) {
+        Corpus::Query query;
+        query.fixture = static_cast<int>(rng() % corpus.fixtures.size());
+        const std::vector<int>& positions = corpus.fixtures[query.fixture].board.getPositions();
+        query.from = static_cast<int>(rng() % Position::NUM_POINTS);
+        for (int step = 0; step < Position::NUM_POINTS && positions[query.from] < 0; ++step) {
+            query.from = (query.from + 1) % Position::NUM_POINTS;
+        }
+        query.to = static_cast<int>(rng() % Position::NUM_POINTS);
+        query.color = positions[query.from] >= 0 ? positions[query.from] : 0;
+        corpus.queries.push_back(query);
+    }
+}
+
+volatile long long sink = 0;
+
+// Calls body, which performs opsPerCall operations, for minMs in total. The time is the
+// best of several rounds, which filters out interruptions from the rest of the system.
+template <typename Body>
+Result measure(const std::string& name, uint64_t opsPerCall, int minMs, Body body) {
+    const int rounds = 5;
+    sink = sink + body();
+    Result result;
+    result.name = name;
+    uint64_t allocated = 0;
+    for (int round = 0; round < rounds; ++round) {
+        const uint64_t allocationsBefore = allocations;
+        const auto start = std::chrono::steady_clock::now();
+        uint64_t ops = 0;
+        double elapsedNs = 0;
+        do {
+            sink = sink + body();
+            ops += opsPerCall;
+            elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsedNs < minMs * 1e6 / rounds);
+        allocated += allocations - allocationsBefore;
+        result.ops += ops;
+        double nsPerOp = elapsedNs / ops;
+        if (round == 0 || nsPerOp < result.nsPerOp) result.nsPerOp = nsPerOp;
+    }
+    result.allocsPerOp = static_cast<double>(allocated) / result.ops;
+    return result;
+}
+
+std::vector<Result> runBenchmarks(const Options& options, Corpus& corpus) {
+    std::vector<Result> results;
+    auto run = [&](const std::string& name, uint64_t opsPerCall, const std::function<long long()>& body) {
+        if (name.find(options.filter) == std::string::npos) return;
+        results.push_back(measure(name, opsPerCall, options.minMs, body));
+        std::cerr << "  " << name << "\n";
+    };
+    const auto& queries = corpus.queries;
+
+    run("board.isMillFormed", queries.size(), [&] {
+        long long sum = 0;
+        for (const auto& q : queries) sum += corpus.millFixtures[q.fixture].board.isMillFormed(q.from, q.color);
+        return sum;
+    });
+    run("board.isValidMove", queries.size(), [&] {
+        long long sum = 0;
+        for (const auto& q : queries) sum += corpus.fixtures[q.fixture].board.isValidMove(q.from, q.to, q.color, false);
+        return sum;
+    });
+    run("board.isAdjacent", queries.size(), [&] {
+        long long sum = 0;
+        for (const auto& q : queries) sum += corpus.fixtures[q.fixture].board.isAdjacent(q.from, q.to);
+        return sum;
+    });
+    run("board.getRemovableOpponentPieces", corpus.fixtures.size(), [&] {
+        long long sum = 0;
+        for (std::size_t i = 0; i < corpus.fixtures.size(); ++i) {
+            sum += corpus.fixtures[i].board.getRemovableOpponentPieces(1 - corpus.sideToMove[i]).size();
+        }
+        return sum;
+    });
+    run("board.canFly", corpus.fixtures.size() * 2, [&] {
+        long long sum = 0;
+        for (const Fixture& fixture : corpus.fixtures) sum += fixture.board.canFly(0) + fixture.board.canFly(1);
+        return sum;
+    });
+    run("player.availableToPlace", corpus.fixtures.size() * 2, [&] {
+        long long sum = 0;
+        for (const Fixture& fixture : corpus.fixtures) {
+            sum += fixture.players[0].availableToPlace() + fixture.players[1].availableToPlace();
+        }
+        return sum;
+    });
+    run("player.activePieces", corpus.fixtures.size() * 2, [&] {
+        long long sum = 0;
+        for (const Fixture& fixture : corpus.fixtures) {
+            sum += fixture.players[0].activePieces() + fixture.players[1].activePieces();
+        }
+        return sum;
+    });
+    run("game.replay", corpus.games.size(), [&] {
+        long long sum = 0;
+        for (const auto& game : corpus.games) {
+            Fixture fixture;
+            for (std::size_t ply = 0; ply < game.size(); ++ply) applyMove(fixture, game[ply], ply % 2);
+            sum += fixture.players[0].activePieces() - fixture.players[1].activePieces();
+        }
+        return sum;
+    });
+    return results;
+}
+
+void writeResults(std::ostream& out, const std::vector<Result>& results) {
+    out << "benchmark\tns_per_op\tallocs_per_op\tops\n";
+    for (const Result& r : results) {
+        out << r.name << '\t' << std::fixed << std::setprecision(2) << r.nsPerOp << '\t' << std::setprecision(3)
+            << r.allocsPerOp << '\t' << r.ops << '\n';
+    }
+}
+
+std::map<std::string, Result> readResults(const std::string& filename) {
+    std::ifstream in(filename);
+    if (!in) throw std::runtime_error("Cannot open " + filename);
+    std::map<std::string, Result> results;
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        Result r;
+        if (fields >> r.name >> r.nsPerOp >> r.allocsPerOp >> r.ops) results[r.name] = r;
+    }
+    return results;
+}
+
+// Time may grow by threshold percent; allocation counts are deterministic and may not grow at all.
+bool compareWithBaseline(const std::vector<Result>& results, const std::map<std::string, Result>& baseline,
+                         double threshold) {
+    bool regressed = false;
+    std::cerr << std::left << std::setw(34) << "benchmark" << std::right << std::setw(12) << "baseline"
+              << std::setw(12) << "now" << std::setw(10) << "change" << "\n";
+    for (const Result& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end()) {
+            std::cerr << std::left << std::setw(34) << r.name << std::right << std::setw(12) << "-" << "\n";
+            continue;
+        }
+        const Result& base = it->second;
+        double change = base.nsPerOp > 0 ? 100.0 * (r.nsPerOp - base.nsPerOp) / base.nsPerOp : 0;
+        bool slower = change > threshold;
+        bool allocates = r.allocsPerOp > base.allocsPerOp + 0.0005;
+        std::cerr << std::left << std::setw(34) << r.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << base.nsPerOp << std::setw(12) << r.nsPerOp << std::setw(9)
+                  << std::setprecision(1) << change << "%";
+        if (slower) std::cerr << "  REGRESSION (time)";
+        if (allocates) std::cerr << "  REGRESSION (" << base.allocsPerOp << " -> " << r.allocsPerOp << " allocs/op)";
+        std::cerr << "\n";
+        regressed = regressed || slower || allocates;
+    }
+    return !regressed;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue) options.output = argv[++i];
+        else if (arg == "--baseline" && hasValue) options.baseline = argv[++i];
+        else if (arg == "--threshold" && hasValue) options.threshold = std::atof(argv[++i]);
+        else if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--min-ms" && hasValue) options.minMs = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) options.seed = static_cast<unsigned>(std::atoi(argv[++i]));
+        else return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: bench [--output FILE] [--baseline FILE] [--threshold PCT] [--filter TEXT]\n"
+                     "             [--min-ms N] [--seed N]\n";
+        return 1;
+    }
+    try {
+        Corpus corpus;
+        buildCorpus(options, corpus);
+        std::cerr << "Running benchmarks (seed " << options.seed << ", " << corpus.fixtures.size() << " positions, "
+                  << corpus.games.size() << " games)\n";
+        std::vector<Result> results = runBenchmarks(options, corpus);
+
+        if (options.output.empty()) {
+            writeResults(std::cout, results);
+        } else {
+            std::ofstream out(options.output);
+            writeResults(out, results);
+            if (!out) throw std::runtime_error("Cannot write " + options.output);
+        }
+        if (!options.baseline.empty() &&
+            !compareWithBaseline(results, readResults(options.baseline), options.threshold)) {
+            std::cerr << "Performance regression beyond " << options.threshold << "%\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -39,44 +39,39 @@ Board::Board(){
 }
 
 void Board::validatePosition(int pos) const {
-    if (pos < 0 || pos >= 24) {
-        throw std::out_of_range("Invalid board position (must be [1-24])");
+    CheckedPolicy::validate(pos);
+}
+
+const char* Board::statusMessage(BoardStatus status) {
+    switch (status) {
+        case BoardStatus::OK:                 return "OK";
+        case BoardStatus::INVALID_POSITION:   return "Invalid board position (must be [1-24])";
+        case BoardStatus::POSITION_OCCUPIED:  return "Position already occupied";
+        case BoardStatus::SOURCE_EMPTY:       return "No piece at source position";
+        case BoardStatus::TARGET_OCCUPIED:    return "Target position occupied";
+        case BoardStatus::NOT_ADJACENT:       return "Positions are not adjacent";
+        case BoardStatus::NO_PIECE_AT_SOURCE: return "Internal error: source spot has no piece";
+        case BoardStatus::NOTHING_TO_REMOVE:  return "No piece to remove";
     }
+    return "Unknown board error";
+}
+
+void Board::throwOnError(BoardStatus status) const {
+    if (status == BoardStatus::OK) return;
+    if (status == BoardStatus::INVALID_POSITION) throw std::out_of_range(statusMessage(status));
+    throw std::runtime_error(statusMessage(status));
 }
 
 void Board::placePiece(int playerColor, int pos) {
-    validatePosition(pos);
-    if (!isPositionEmpty(pos)) throw std::runtime_error("Position already occupied");
-    positions_[pos] = playerColor;
+    throwOnError(tryPlacePiece<CheckedPolicy>(playerColor, pos));
 }
 
 void Board::movePiece(int from, int to) {
-    validatePosition(from);
-    validatePosition(to);
-
-    if (isPositionEmpty(from)) throw std::runtime_error("No piece at source position");
-    if (!isPositionEmpty(to)) throw std::runtime_error("Target position occupied");
-    if (!isAdjacent(from, to)) throw std::runtime_error("Positions are not adjacent");
-
-    int player = positions_[from];
-    Spot* fromSpot = getSpot(from);
-    Spot* toSpot = getSpot(to);
-    Piece* movingPiece = fromSpot->getPiece();
-    if (!movingPiece) throw std::runtime_error("Internal error: source spot has no piece");
-    fromSpot->removePiece();
-    toSpot->placePiece(movingPiece);
-    movingPiece->place(toSpot);
-    positions_[from] = -1;
-    positions_[to] = player;
+    throwOnError(tryMovePiece<CheckedPolicy>(from, to));
 }
 
 void Board::removePiece(int pos) {
-    validatePosition(pos);
-    if (isPositionEmpty(pos)) throw std::runtime_error("No piece to remove");
-    Spot* spot = getSpot(pos);
-    if (Piece* piece = spot->getPiece()) {piece->removeFromBoard();}
-    spot->removePiece(); 
-    positions_[pos] = -1;
+    throwOnError(tryRemovePiece<CheckedPolicy>(pos));
 }
 
 bool Board::canFly(int playerColor) const {
@@ -99,7 +94,7 @@ bool Board::isMillFormed(int lastMovePos, int playerColor) {
         if (std::find(mill.begin(), mill.end(), lastMovePos) != mill.end()) {
             bool completeMill = true;
             for (int pos : mill){
-                if (!isPositionOwnedBy(pos, playerColor)) {
+                if (!isPositionOwnedBy<UncheckedPolicy>(pos, playerColor)) {
                     completeMill = false;
                     break;
                 }
@@ -107,7 +102,7 @@ bool Board::isMillFormed(int lastMovePos, int playerColor) {
             if (completeMill) {
                 millFound = true;
                 for (int pos : mill) {
-                    Spot* spot = getSpot(pos);
+                    Spot* spot = getSpot<UncheckedPolicy>(pos);
                     if (spot && spot->getPiece()) {
                         spot->getPiece()->setMillStatus(true);
                     }
@@ -148,25 +143,19 @@ void Board::displayBoardWithReference() const {
 }
 
 bool Board::isPositionEmpty(int pos) const {
-    validatePosition(pos);
-    return positions_[pos] == -1;
+    return isPositionEmpty<CheckedPolicy>(pos);
 }
 
 bool Board::isPositionOwnedBy(int pos, int playerColor) const {
-    validatePosition(pos);
-    return positions_[pos] == playerColor;
+    return isPositionOwnedBy<CheckedPolicy>(pos, playerColor);
 }
 
 bool Board::isAdjacent(int from, int to) const {
-    validatePosition(from);
-    validatePosition(to);
-    const auto& adjacent = adjacency_[from];
-    return std::find(adjacent.begin(), adjacent.end(), to) != adjacent.end();
+    return isAdjacent<CheckedPolicy>(from, to);
 }
 
 const std::vector<int>& Board::getAdjacentPositions(int pos) const {
-    validatePosition(pos);
-    return adjacency_[pos];
+    return getAdjacentPositions<CheckedPolicy>(pos);
 }
 
 const std::vector<int>& Board::getPositions() const {return positions_;}
@@ -177,13 +166,11 @@ void Board::setPositions(const std::vector<int>& positions) {
 }
 
 Spot* Board::getSpot(int pos) {
-    validatePosition(pos);
-    return &spots_[pos];
+    return getSpot<CheckedPolicy>(pos);
 }
 
 const Spot* Board::getSpot(int pos) const {
-    validatePosition(pos);
-    return &spots_[pos];
+    return getSpot<CheckedPolicy>(pos);
 } 
 
 std::vector<int> Board::getRemovableOpponentPieces(int opponentColor) const {
@@ -191,7 +178,7 @@ std::vector<int> Board::getRemovableOpponentPieces(int opponentColor) const {
 
     for (int pos = 0; pos < 24; ++pos) {
         if (positions_[pos] == opponentColor) {
-            const Spot* spot = getSpot(pos);
+            const Spot* spot = getSpot<UncheckedPolicy>(pos);
             if (spot && spot->getPiece() && !spot->getPiece()->isInMill()) {
                 removablePieces.push_back(pos);
             }
@@ -199,7 +186,7 @@ std::vector<int> Board::getRemovableOpponentPieces(int opponentColor) const {
     }
 
     if (removablePieces.empty()) {
-        for (int pos = 0; pos <= 24; ++pos) {
+        for (int pos = 0; pos < 24; ++pos) {
             if (positions_[pos] == opponentColor) {
                 removablePieces.push_back(pos);
             }
@@ -4,9 +4,35 @@
 #include <stdexcept>
 #include "Spot.h"
 
+enum class BoardStatus {
+    OK,
+    INVALID_POSITION,
+    POSITION_OCCUPIED,
+    SOURCE_EMPTY,
+    TARGET_OCCUPIED,
+    NOT_ADJACENT,
+    NO_PIECE_AT_SOURCE,
+    NOTHING_TO_REMOVE
+};
+
+// Validation policies for Board operations. CheckedPolicy is for user input and
+// throws std::out_of_range from accessors; UncheckedPolicy is for moves the engine
+// already knows to be legal and compiles every check away.
+struct CheckedPolicy {
+    static const bool CHECKS = true;
+    static void validate(int pos) {
+        if (pos < 0 || pos >= 24) throw std::out_of_range("Invalid board position (must be [1-24])");
+    }
+};
+
+struct UncheckedPolicy {
+    static const bool CHECKS = false;
+    static void validate(int) noexcept {}
+};
+
 class Board {
 public:
-    Board(); 
+    Board();
     bool isValidMove(int from, int to, int playerColor, bool isFlying) const;
     bool isMillFormed(int lastMovePos, int playerColor);
     bool canFly(int playerColor) const;
@@ -14,11 +40,22 @@ public:
     bool isPositionOwnedBy(int pos, int playerColor) const;
     bool isAdjacent(int from, int to) const;
 
+    template <typename Policy> bool isPositionEmpty(int pos) const noexcept(!Policy::CHECKS);
+    template <typename Policy> bool isPositionOwnedBy(int pos, int playerColor) const noexcept(!Policy::CHECKS);
+    template <typename Policy> bool isAdjacent(int from, int to) const noexcept(!Policy::CHECKS);
+
     void placePiece(int playerColor, int pos);
     void movePiece(int from, int to);
     void removePiece(int pos);
 
+    // Status-code variants: never throw. Unchecked calls assume a legal request.
+    template <typename Policy = CheckedPolicy> BoardStatus tryPlacePiece(int playerColor, int pos) noexcept;
+    template <typename Policy = CheckedPolicy> BoardStatus tryMovePiece(int from, int to) noexcept;
+    template <typename Policy = CheckedPolicy> BoardStatus tryRemovePiece(int pos) noexcept;
+    static const char* statusMessage(BoardStatus status);
+
     const std::vector<int>& getAdjacentPositions(int pos) const;
+    template <typename Policy> const std::vector<int>& getAdjacentPositions(int pos) const noexcept(!Policy::CHECKS);
     const std::vector<std::vector<int>>& getAllMills() const;
     const std::vector<int>& getPositions() const;
 
@@ -27,11 +64,100 @@ public:
     void setPositions(const std::vector<int>& positions);
     Spot* getSpot(int pos);
     const Spot* getSpot(int pos) const;
+    template <typename Policy> Spot* getSpot(int pos) noexcept(!Policy::CHECKS);
+    template <typename Policy> const Spot* getSpot(int pos) const noexcept(!Policy::CHECKS);
 
 private:
-    std::vector<int> positions_;                
-    std::vector<std::vector<int>> mills_;           
-    std::vector<std::vector<int>> adjacency_;       
-    std::vector<Spot> spots_;                       
+    std::vector<int> positions_;
+    std::vector<std::vector<int>> mills_;
+    std::vector<std::vector<int>> adjacency_;
+    std::vector<Spot> spots_;
     void validatePosition(int pos) const;
-}; 
+    void throwOnError(BoardStatus status) const;
+    static bool isValidPosition(int pos) noexcept { return pos >= 0 && pos < 24; }
+};
+
+template <typename Policy>
+bool Board::isPositionEmpty(int pos) const noexcept(!Policy::CHECKS) {
+    Policy::validate(pos);
+    return positions_[pos] == -1;
+}
+
+template <typename Policy>
+bool Board::isPositionOwnedBy(int pos, int playerColor) const noexcept(!Policy::CHECKS) {
+    Policy::validate(pos);
+    return positions_[pos] == playerColor;
+}
+
+template <typename Policy>
+bool Board::isAdjacent(int from, int to) const noexcept(!Policy::CHECKS) {
+    Policy::validate(from);
+    Policy::validate(to);
+    for (int adj : adjacency_[from]) {
+        if (adj == to) return true;
+    }
+    return false;
+}
+
+template <typename Policy>
+const std::vector<int>& Board::getAdjacentPositions(int pos) const noexcept(!Policy::CHECKS) {
+    Policy::validate(pos);
+    return adjacency_[pos];
+}
+
+template <typename Policy>
+Spot* Board::getSpot(int pos) noexcept(!Policy::CHECKS) {
+    Policy::validate(pos);
+    return &spots_[pos];
+}
+
+template <typename Policy>
+const Spot* Board::getSpot(int pos) const noexcept(!Policy::CHECKS) {
+    Policy::validate(pos);
+    return &spots_[pos];
+}
+
+template <typename Policy>
+BoardStatus Board::tryPlacePiece(int playerColor, int pos) noexcept {
+    if (Policy::CHECKS) {
+        if (!isValidPosition(pos)) return BoardStatus::INVALID_POSITION;
+        if (positions_[pos] != -1) return BoardStatus::POSITION_OCCUPIED;
+    }
+    positions_[pos] = playerColor;
+    return BoardStatus::OK;
+}
+
+template <typename Policy>
+BoardStatus Board::tryMovePiece(int from, int to) noexcept {
+    if (Policy::CHECKS) {
+        if (!isValidPosition(from) || !isValidPosition(to)) return BoardStatus::INVALID_POSITION;
+        if (positions_[from] == -1) return BoardStatus::SOURCE_EMPTY;
+        if (positions_[to] != -1) return BoardStatus::TARGET_OCCUPIED;
+        if (!canFly(positions_[from]) && !isAdjacent<UncheckedPolicy>(from, to)) return BoardStatus::NOT_ADJACENT;
+        if (!spots_[from].getPiece()) return BoardStatus::NO_PIECE_AT_SOURCE;
+    }
+
+    Spot& fromSpot = spots_[from];
+    Spot& toSpot = spots_[to];
+    if (Piece* movingPiece = fromSpot.getPiece()) {
+        fromSpot.removePiece();
+        toSpot.placePiece(movingPiece);
+        movingPiece->place(&toSpot);
+    }
+    positions_[to] = positions_[from];
+    positions_[from] = -1;
+    return BoardStatus::OK;
+}
+
+template <typename Policy>
+BoardStatus Board::tryRemovePiece(int pos) noexcept {
+    if (Policy::CHECKS) {
+        if (!isValidPosition(pos)) return BoardStatus::INVALID_POSITION;
+        if (positions_[pos] == -1) return BoardStatus::NOTHING_TO_REMOVE;
+    }
+    Spot& spot = spots_[pos];
+    if (Piece* piece = spot.getPiece()) {piece->removeFromBoard();}
+    spot.removePiece();
+    positions_[pos] = -1;
+    return BoardStatus::OK;
+}
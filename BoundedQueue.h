@@ -0,0 +1,74 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+// Fixed-capacity MPMC queue: push() blocks while full, which is what gives the
+// streaming tools their back-pressure. close() wakes everyone; pop() then drains
+// the remaining items and returns false once the queue is empty.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity ? capacity : 1), closed_(false) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+private:
+    std::size_t capacity_;
+    bool closed_;
+    std::deque<T> items_;
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+};
+
+// Admits items in index order while at most size of them are unfinished, so a
+// writer that reorders results never buffers more than size items.
+class InFlightWindow {
+public:
+    explicit InFlightWindow(std::size_t size) : size_(size), written_(0) {}
+
+    void acquire(std::size_t index) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        released_.wait(lock, [&] { return index < written_ + size_; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++written_;
+        released_.notify_all();
+    }
+
+private:
+    std::size_t size_;
+    std::size_t written_;
+    std::mutex mutex_;
+    std::condition_variable released_;
+};
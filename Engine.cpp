@@ -0,0 +1,290 @@
+#include "Engine.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+int scoreToTable(int score, int ply) {
+    if (score >= Engine::SCORE_WIN_THRESHOLD) return score + ply;
+    if (score <= -Engine::SCORE_WIN_THRESHOLD) return score - ply;
+    return score;
+}
+
+int scoreFromTable(int score, int ply) {
+    if (score >= Engine::SCORE_WIN_THRESHOLD) return score - ply;
+    if (score <= -Engine::SCORE_WIN_THRESHOLD) return score + ply;
+    return score;
+}
+
+int sideScore(const Position& pos, int color, const EvalWeights& weights) {
+    const uint32_t ours = pos.occupancy(color);
+    const uint32_t empty = pos.emptyPoints();
+    int score = (pos.piecesOnBoard(color) + pos.piecesInHand(color)) * weights.material;
+
+    if (pos.phase(color) == Position::Phase::MOVING) {
+        for (uint32_t bits = ours; bits; bits &= bits - 1) {
+            score += popCount(Position::adjacentMask(lowestBit(bits)) & empty) * weights.mobility;
+        }
+    }
+    for (int i = 0; i < Position::millCount(); ++i) {
+        uint32_t mill = Position::millMask(i);
+        int owned = popCount(ours & mill);
+        if (owned == 3) score += weights.closedMill;
+        else if (owned == 2 && (empty & mill)) score += weights.openMill;
+    }
+    return score;
+}
+
+// Keeps network scores clear of the range reserved for forced wins.
+int clampScore(int score) {
+    return std::max(-Engine::SCORE_WIN_THRESHOLD + 1, std::min(Engine::SCORE_WIN_THRESHOLD - 1, score));
+}
+
+}
+
+Engine::Engine(std::size_t ttEntries, const EvalWeights& weights) : weights_(weights), nodes_(0), aborted_(false) {
+    std::size_t size = 1;
+    while (size * 2 <= ttEntries) size *= 2;
+    table_.resize(size);
+    tableMask_ = size - 1;
+    clear();
+}
+
+void Engine::clear() {
+    std::fill(table_.begin(), table_.end(), TTEntry());
+    for (auto& killers : killers_) killers[0] = killers[1] = Move();
+}
+
+int Engine::evaluate(const Position& pos) const {
+    if (network_) return clampScore(network_->evaluate(pos));
+    const int us = pos.sideToMove();
+    return sideScore(pos, us, weights_) - sideScore(pos, 1 - us, weights_);
+}
+
+// Inside the search the network reads the accumulator kept up to date along the current line.
+int Engine::evaluate(const Position& pos, int ply) const {
+    if (network_) return clampScore(network_->evaluate(accumulators_[ply], pos.sideToMove()));
+    return evaluate(pos);
+}
+
+void Engine::startSearch(const SearchLimits& limits) {
+    limits_ = limits;
+    nodes_ = 0;
+    aborted_ = false;
+    startTime_ = std::chrono::steady_clock::now();
+}
+
+SearchResult Engine::search(const Position& root, const SearchLimits& limits) {
+    startSearch(limits);
+
+    SearchResult result;
+    if (root.isLost()) {
+        result.score = -SCORE_WIN;
+        return result;
+    }
+
+    std::vector<Move> rootMoves;
+    root.generateMoves(rootMoves);
+    result.bestMove = rootMoves.front();
+    result.pv.assign(1, rootMoves.front());
+    if (network_) network_->refresh(root, accumulators_[0]);
+
+    const int maxDepth = std::max(1, std::min(limits.depth, static_cast<int>(MAX_PLY)));
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        int score = negamax(root, depth, 0, -SCORE_WIN, SCORE_WIN);
+        if (aborted_) break;
+
+        result.score = score;
+        result.depth = depth;
+        result.pv.assign(pv_[0], pv_[0] + pvLength_[0]);
+        if (!result.pv.empty()) result.bestMove = result.pv.front();
+        if (isWinScore(score) && SCORE_WIN - std::abs(score) <= depth) break;
+    }
+    result.nodes = nodes_;
+    return result;
+}
+
+// Each root move is searched with alpha just below the score of the lines-th best move so
+// far, so moves that cannot enter the top lines fail low cheaply while ties with it, like
+// every move above it, get exact scores.
+std::vector<SearchResult> Engine::searchMultiPv(const Position& root, const SearchLimits& limits, int lines,
+                                                const LinesCallback& onDepth) {
+    startSearch(limits);
+
+    std::vector<SearchResult> best;
+    if (root.isLost()) return best;
+
+    std::vector<Move> rootMoves;
+    root.generateMoves(rootMoves);
+    std::vector<SearchResult> candidates(rootMoves.size());
+    for (std::size_t i = 0; i < rootMoves.size(); ++i) {
+        candidates[i].bestMove = rootMoves[i];
+        candidates[i].pv.assign(1, rootMoves[i]);
+    }
+    const std::size_t count = std::min(candidates.size(), static_cast<std::size_t>(std::max(1, lines)));
+    // Like search(), a stop before the first iteration completes still yields moves (at depth 0).
+    best.assign(candidates.begin(), candidates.begin() + count);
+    if (network_) network_->refresh(root, accumulators_[0]);
+
+    std::vector<int> exactScores;
+    const int maxDepth = std::max(1, std::min(limits.depth, static_cast<int>(MAX_PLY)));
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        exactScores.clear();
+        for (SearchResult& candidate : candidates) {
+            int alpha = -SCORE_WIN;
+            if (exactScores.size() >= count) {
+                std::nth_element(exactScores.begin(), exactScores.begin() + (count - 1), exactScores.end(), std::greater<int>());
+                alpha = exactScores[count - 1] - 1;
+            }
+            const Move move = candidate.bestMove;
+            Position child = root;
+            child.makeMove(move);
+            if (network_) network_->update(accumulators_[0], root, move, accumulators_[1]);
+            int score = -negamax(child, depth - 1, 1, -SCORE_WIN, -alpha);
+            if (aborted_) break;
+
+            candidate.score = score;
+            candidate.depth = depth;
+            candidate.pv.assign(1, move);
+            candidate.pv.insert(candidate.pv.end(), pv_[1], pv_[1] + pvLength_[1]);
+            if (score > alpha) exactScores.push_back(score);
+        }
+        if (aborted_) break;
+
+        // Fail-low scores are upper bounds strictly below the top lines, so sorting keeps those exact.
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const SearchResult& a, const SearchResult& b) { return a.score > b.score; });
+        best.assign(candidates.begin(), candidates.begin() + count);
+        for (SearchResult& line : best) line.nodes = nodes_;
+        if (onDepth) onDepth(best);
+        bool resolved = true;
+        for (const SearchResult& line : best) {
+            resolved = resolved && isWinScore(line.score) && SCORE_WIN - std::abs(line.score) <= depth;
+        }
+        if (resolved) break;
+    }
+    return best;
+}
+
+std::string Engine::formatScore(int score) {
+    if (score >= SCORE_WIN_THRESHOLD) return "#" + std::to_string(SCORE_WIN - score);
+    if (score <= -SCORE_WIN_THRESHOLD) return "#-" + std::to_string(SCORE_WIN + score);
+    return std::to_string(score);
+}
+
+bool Engine::shouldStop() {
+    if (limits_.stop && limits_.stop->load(std::memory_order_relaxed)) return true;
+    if (limits_.nodes && nodes_ >= limits_.nodes) return true;
+    if (limits_.moveTimeMs && (nodes_ & 1023) == 0) {
+        auto elapsed = std::chrono::steady_clock::now() - startTime_;
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >= limits_.moveTimeMs;
+    }
+    return false;
+}
+
+int Engine::negamax(const Position& pos, int depth, int ply, int alpha, int beta) {
+    pvLength_[ply] = 0;
+    ++nodes_;
+    if (aborted_ || shouldStop()) {
+        aborted_ = true;
+        return 0;
+    }
+
+    const int us = pos.sideToMove();
+    if (pos.piecesOnBoard(us) + pos.piecesInHand(us) < 3) return -SCORE_WIN + ply;
+    if (ply > 0 && pos.isDraw()) return 0;
+
+    std::vector<Move>& moves = moveStack_[ply];
+    pos.generateMoves(moves);
+    if (moves.empty()) return -SCORE_WIN + ply;
+    if (depth <= 0 || ply >= MAX_PLY) return evaluate(pos, ply);
+
+    Move ttMove;
+    TTEntry* entry = probe(pos.key());
+    if (entry) {
+        ttMove = Move::unpack(entry->move);
+        if (ply > 0 && entry->depth >= depth) {
+            int score = scoreFromTable(entry->score, ply);
+            if (entry->bound == BOUND_EXACT ||
+                (entry->bound == BOUND_LOWER && score >= beta) ||
+                (entry->bound == BOUND_UPPER && score <= alpha)) {
+                return score;
+            }
+        }
+    }
+
+    orderMoves(moves, ply, ttMove);
+
+    const int originalAlpha = alpha;
+    int bestScore = -SCORE_WIN;
+    Move bestMove = moves.front();
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const Move move = moves[i];
+        Position child = pos;
+        child.makeMove(move);
+        if (network_) network_->update(accumulators_[ply], pos, move, accumulators_[ply + 1]);
+        int score = -negamax(child, depth - 1, ply + 1, -beta, -alpha);
+        if (aborted_) return 0;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+                pv_[ply][0] = move;
+                std::copy(pv_[ply + 1], pv_[ply + 1] + pvLength_[ply + 1], pv_[ply] + 1);
+                pvLength_[ply] = pvLength_[ply + 1] + 1;
+            }
+        }
+        if (alpha >= beta) {
+            if (!move.isCapture() && move != killers_[ply][0]) {
+                killers_[ply][1] = killers_[ply][0];
+                killers_[ply][0] = move;
+            }
+            break;
+        }
+    }
+
+    Bound bound = bestScore >= beta ? BOUND_LOWER : (bestScore > originalAlpha ? BOUND_EXACT : BOUND_UPPER);
+    store(pos.key(), depth, ply, bestScore, bound, bestMove);
+    return bestScore;
+}
+
+void Engine::orderMoves(std::vector<Move>& moves, int ply, const Move& ttMove) {
+    std::vector<int>& scores = orderStack_[ply];
+    scores.resize(moves.size());
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        if (move == ttMove) scores[i] = 1000000;
+        else if (move.isCapture()) scores[i] = 10000;
+        else if (move == killers_[ply][0]) scores[i] = 9000;
+        else if (move == killers_[ply][1]) scores[i] = 8000;
+        else scores[i] = 0;
+    }
+    for (std::size_t i = 1; i < moves.size(); ++i) {
+        Move move = moves[i];
+        int score = scores[i];
+        std::size_t j = i;
+        for (; j > 0 && scores[j - 1] < score; --j) {
+            moves[j] = moves[j - 1];
+            scores[j] = scores[j - 1];
+        }
+        moves[j] = move;
+        scores[j] = score;
+    }
+}
+
+Engine::TTEntry* Engine::probe(uint64_t key) {
+    TTEntry& entry = table_[key & tableMask_];
+    return (entry.bound != BOUND_NONE && entry.key == key) ? &entry : nullptr;
+}
+
+void Engine::store(uint64_t key, int depth, int ply, int score, Bound bound, const Move& move) {
+    TTEntry& entry = table_[key & tableMask_];
+    if (entry.key == key && entry.depth > depth && bound != BOUND_EXACT) return;
+    entry.key = key;
+    entry.score = static_cast<int16_t>(scoreToTable(score, ply));
+    entry.move = move.pack();
+    entry.depth = static_cast<int8_t>(depth);
+    entry.bound = bound;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Nnue.h"
+#include "Position.h"
+
+struct SearchLimits {
+    int depth;
+    uint64_t nodes;   // 0 = unlimited
+    int moveTimeMs;   // 0 = unlimited
+    const std::atomic<bool>* stop;   // owned by the caller, polled every node
+
+    SearchLimits(int depth = 32, uint64_t nodes = 0, int moveTimeMs = 0, const std::atomic<bool>* stop = nullptr)
+        : depth(depth), nodes(nodes), moveTimeMs(moveTimeMs), stop(stop) {}
+};
+
+struct EvalWeights {
+    int material = 100;
+    int mobility = 4;
+    int openMill = 12;
+    int closedMill = 8;
+};
+
+struct SearchResult {
+    Move bestMove;
+    int score = 0;    // from the side to move's point of view
+    int depth = 0;
+    uint64_t nodes = 0;
+    std::vector<Move> pv;
+};
+
+// Iterative deepening alpha-beta over Position. One Engine per thread; the
+// transposition table persists between searches until clear() is called.
+class Engine {
+public:
+    static const int MAX_PLY = 64;
+    static const int SCORE_WIN = 30000;
+    static const int SCORE_WIN_THRESHOLD = SCORE_WIN - 1000;
+
+    explicit Engine(std::size_t ttEntries = 1 << 20, const EvalWeights& weights = EvalWeights());
+
+    typedef std::function<void(const std::vector<SearchResult>&)> LinesCallback;
+
+    SearchResult search(const Position& root, const SearchLimits& limits);
+    // Best `lines` root moves with exact scores, best first. onDepth receives them after
+    // every completed iteration; the returned lines are from the last completed one.
+    std::vector<SearchResult> searchMultiPv(const Position& root, const SearchLimits& limits, int lines,
+                                            const LinesCallback& onDepth = LinesCallback());
+    int evaluate(const Position& pos) const;
+    void clear();
+
+    // Evaluates with the network instead of EvalWeights; nullptr restores the classic evaluation.
+    void setNetwork(std::shared_ptr<const Nnue> network) { network_ = std::move(network); }
+    bool hasNetwork() const { return network_ != nullptr; }
+
+    static bool isWinScore(int score) { return score >= SCORE_WIN_THRESHOLD || score <= -SCORE_WIN_THRESHOLD; }
+    // "#N" / "#-N" for a forced win / loss in N plies, otherwise the score itself.
+    static std::string formatScore(int score);
+
+private:
+    enum Bound : uint8_t { BOUND_NONE, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT };
+
+    struct TTEntry {
+        uint64_t key;
+        int16_t score;
+        uint16_t move;
+        int8_t depth;
+        uint8_t bound;
+    };
+
+    EvalWeights weights_;
+    std::shared_ptr<const Nnue> network_;
+    Nnue::Accumulator accumulators_[MAX_PLY + 1];
+    std::vector<TTEntry> table_;
+    uint64_t tableMask_;
+    std::vector<Move> moveStack_[MAX_PLY + 1];
+    std::vector<int> orderStack_[MAX_PLY + 1];
+    Move killers_[MAX_PLY + 1][2];
+    Move pv_[MAX_PLY + 1][MAX_PLY + 1];
+    int pvLength_[MAX_PLY + 1];
+
+    SearchLimits limits_;
+    uint64_t nodes_;
+    bool aborted_;
+    std::chrono::steady_clock::time_point startTime_;
+
+    int evaluate(const Position& pos, int ply) const;
+    void startSearch(const SearchLimits& limits);
+    int negamax(const Position& pos, int depth, int ply, int alpha, int beta);
+    void orderMoves(std::vector<Move>& moves, int ply, const Move& ttMove);
+    bool shouldStop();
+    TTEntry* probe(uint64_t key);
+    void store(uint64_t key, int depth, int ply, int score, Bound bound, const Move& move);
+};
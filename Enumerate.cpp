@@ -0,0 +1,384 @@
+#include "Position.h"
+#include "PositionIndex.h"
+#include "VisitedSet.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Level-synchronous BFS over every state reachable from the start position. Each
+// level is a set of frontier files of state ranks that workers expand in chunks.
+// Children new to the level go to a separate "discovered" bitset and the next
+// frontier; only once that frontier is complete are its ranks merged into the
+// visited bitset. A run interrupted mid-level therefore leaves the visited set as
+// of the last checkpoint, and --resume restarts that level.
+
+namespace {
+
+const std::size_t CHUNK_SIZE = 1 << 16;
+
+struct Options {
+    std::string dir;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int maxLevel = -1;
+    bool resume = false;
+};
+
+// Counts over expanded states; terminal states are counted but not expanded.
+struct Stats {
+    uint64_t states = 0;
+    uint64_t byPhase[3] = {};
+    uint64_t byPieces[Position::PIECES_PER_PLAYER + 1][Position::PIECES_PER_PLAYER + 1] = {};
+    uint64_t noMoves = 0;          // blocked: hasValidMoves() is false
+    uint64_t materialLosses = 0;   // fewer than three pieces left
+    uint64_t moves = 0;
+    uint64_t captures = 0;
+    uint64_t millsClosed = 0;      // distinct from/to pairs that close a mill
+    uint64_t statesWithMill = 0;
+
+    void add(const Stats& other) {
+        states += other.states;
+        for (int i = 0; i < 3; ++i) byPhase[i] += other.byPhase[i];
+        for (int l = 0; l <= Position::PIECES_PER_PLAYER; ++l) {
+            for (int d = 0; d <= Position::PIECES_PER_PLAYER; ++d) byPieces[l][d] += other.byPieces[l][d];
+        }
+        noMoves += other.noMoves;
+        materialLosses += other.materialLosses;
+        moves += other.moves;
+        captures += other.captures;
+        millsClosed += other.millsClosed;
+        statesWithMill += other.statesWithMill;
+    }
+
+    void write(std::ostream& out) const {
+        out << "states " << states << "\nphases " << byPhase[0] << " " << byPhase[1] << " " << byPhase[2]
+            << "\nterminals " << noMoves << " " << materialLosses << "\nmoves " << moves << " " << captures
+            << " " << millsClosed << " " << statesWithMill << "\npieces";
+        for (int l = 0; l <= Position::PIECES_PER_PLAYER; ++l) {
+            for (int d = 0; d <= Position::PIECES_PER_PLAYER; ++d) out << " " << byPieces[l][d];
+        }
+        out << "\n";
+    }
+
+    bool read(std::istream& in) {
+        std::string label[5];
+        in >> label[0] >> states >> label[1] >> byPhase[0] >> byPhase[1] >> byPhase[2] >> label[2] >> noMoves >>
+            materialLosses >> label[3] >> moves >> captures >> millsClosed >> statesWithMill >> label[4];
+        for (int l = 0; l <= Position::PIECES_PER_PLAYER; ++l) {
+            for (int d = 0; d <= Position::PIECES_PER_PLAYER; ++d) in >> byPieces[l][d];
+        }
+        return in && label[0] == "states" && label[4] == "pieces";
+    }
+};
+
+struct Checkpoint {
+    int level = 0;
+    unsigned files = 0;
+    bool merged = false;     // frontier of this level already in the visited set
+    std::vector<uint64_t> levelSizes;
+    Stats stats;
+};
+
+std::string levelFile(const std::string& dir, int level, unsigned index) {
+    return dir + "/level_" + std::to_string(level) + "_" + std::to_string(index) + ".bin";
+}
+
+void writeCheckpoint(const std::string& dir, const Checkpoint& checkpoint) {
+    const std::string filename = dir + "/checkpoint.txt";
+    {
+        std::ofstream out(filename + ".tmp", std::ios::trunc);
+        out << "level " << checkpoint.level << "\nfiles " << checkpoint.files << "\nmerged " << checkpoint.merged
+            << "\nsizes";
+        for (uint64_t size : checkpoint.levelSizes) out << " " << size;
+        out << "\n";
+        checkpoint.stats.write(out);
+        if (!out) throw std::runtime_error("Cannot write " + filename);
+    }
+    std::remove(filename.c_str());
+    if (std::rename((filename + ".tmp").c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Cannot write " + filename);
+    }
+}
+
+Checkpoint readCheckpoint(const std::string& dir) {
+    std::ifstream in(dir + "/checkpoint.txt");
+    Checkpoint checkpoint;
+    std::string label, sizes;
+    if (!(in >> label >> checkpoint.level) || label != "level" || !(in >> label >> checkpoint.files) ||
+        label != "files" || !(in >> label >> checkpoint.merged) || label != "merged" || !(in >> label) ||
+        label != "sizes" || !std::getline(in, sizes)) {
+        throw std::runtime_error("Cannot read checkpoint in " + dir);
+    }
+    std::istringstream sizeList(sizes);
+    for (uint64_t size; sizeList >> size;) checkpoint.levelSizes.push_back(size);
+    if (!checkpoint.stats.read(in)) throw std::runtime_error("Cannot read checkpoint in " + dir);
+    return checkpoint;
+}
+
+// Hands out chunks of ranks from the files of one level to the workers.
+class FrontierReader {
+public:
+    explicit FrontierReader(const std::vector<std::string>& files) : files_(files), next_(0) {}
+
+    bool read(std::vector<uint64_t>& chunk) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chunk.resize(CHUNK_SIZE);
+        while (true) {
+            if (!in_.is_open()) {
+                if (next_ == files_.size()) return false;
+                in_.open(files_[next_++], std::ios::binary);
+                if (!in_) throw std::runtime_error("Cannot read " + files_[next_ - 1]);
+            }
+            in_.read(reinterpret_cast<char*>(chunk.data()), CHUNK_SIZE * sizeof(uint64_t));
+            std::size_t count = static_cast<std::size_t>(in_.gcount()) / sizeof(uint64_t);
+            if (count < CHUNK_SIZE) in_.close();
+            if (count > 0) {
+                chunk.resize(count);
+                return true;
+            }
+        }
+    }
+
+private:
+    std::vector<std::string> files_;
+    std::size_t next_;
+    std::ifstream in_;
+    std::mutex mutex_;
+};
+
+class FrontierWriter {
+public:
+    explicit FrontierWriter(const std::string& filename)
+        : filename_(filename), out_(filename, std::ios::binary | std::ios::trunc), written_(0) {
+        if (!out_) throw std::runtime_error("Cannot write " + filename);
+        buffer_.reserve(CHUNK_SIZE);
+    }
+
+    void push(uint64_t rank) {
+        buffer_.push_back(rank);
+        if (buffer_.size() == CHUNK_SIZE) flush();
+    }
+
+    void flush() {
+        out_.write(reinterpret_cast<const char*>(buffer_.data()), buffer_.size() * sizeof(uint64_t));
+        if (!out_) throw std::runtime_error("Cannot write " + filename_);
+        written_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    uint64_t written() const { return written_; }
+
+private:
+    std::string filename_;
+    std::ofstream out_;
+    std::vector<uint64_t> buffer_;
+    uint64_t written_;
+};
+
+std::vector<std::string> levelFiles(const std::string& dir, const Checkpoint& checkpoint) {
+    std::vector<std::string> files;
+    for (unsigned i = 0; i < checkpoint.files; ++i) files.push_back(levelFile(dir, checkpoint.level, i));
+    return files;
+}
+
+void expand(const Position& pos, const VisitedSet& visited, VisitedSet& discovered, FrontierWriter& out,
+            std::vector<Move>& moves, Stats& stats) {
+    const int us = pos.sideToMove();
+    ++stats.states;
+    ++stats.byPhase[static_cast<int>(pos.phase(us))];
+    ++stats.byPieces[pos.piecesOnBoard(0)][pos.piecesOnBoard(1)];
+
+    if (pos.piecesOnBoard(us) + pos.piecesInHand(us) < 3) {
+        ++stats.materialLosses;
+        return;
+    }
+    if (!pos.hasValidMoves()) {
+        ++stats.noMoves;
+        return;
+    }
+
+    pos.generateMoves(moves);
+    stats.moves += moves.size();
+    bool closesMill = false;
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const Move& move = moves[i];
+        if (move.isCapture()) {
+            ++stats.captures;
+            // Captures after the same mill-closing step are generated together.
+            if (i == 0 || moves[i - 1].from != move.from || moves[i - 1].to != move.to) ++stats.millsClosed;
+            closesMill = true;
+        }
+        Position child = pos;
+        child.makeMove(move);
+        uint64_t rank = PositionIndex::rankState(child);
+        if (!visited.test(rank) && discovered.testAndSet(rank)) out.push(rank);
+    }
+    if (closesMill) ++stats.statesWithMill;
+}
+
+// Redoing an interrupted merge is harmless, so the checkpoint only records completion.
+void mergeFrontier(const std::string& dir, Checkpoint& checkpoint, VisitedSet& visited) {
+    FrontierReader reader(levelFiles(dir, checkpoint));
+    std::vector<uint64_t> chunk;
+    while (reader.read(chunk)) {
+        for (uint64_t rank : chunk) visited.testAndSet(rank);
+    }
+    visited.flush();
+    checkpoint.merged = true;
+    writeCheckpoint(dir, checkpoint);
+}
+
+double rate(uint64_t count, double seconds) { return seconds > 0 ? count / seconds : 0; }
+
+void printReport(const Checkpoint& checkpoint) {
+    const Stats& stats = checkpoint.stats;
+    const char* phases[3] = {"placing", "moving", "flying"};
+    std::cout << "\nReachable states: " << stats.states << " over " << checkpoint.levelSizes.size() << " levels\n";
+    for (int i = 0; i < 3; ++i) {
+        std::cout << "  side to move " << std::setw(8) << std::left << phases[i] << std::right << std::setw(16)
+                  << stats.byPhase[i] << "\n";
+    }
+    std::cout << "Terminal states: " << stats.noMoves << " without legal moves, " << stats.materialLosses
+              << " with fewer than three pieces\n";
+    std::cout << "Moves: " << stats.moves << ", captures: " << stats.captures << ", mill closings: "
+              << stats.millsClosed << "\n";
+    if (stats.states > 0 && stats.moves > 0) {
+        std::cout << std::fixed << std::setprecision(4) << "  states that can close a mill: "
+                  << 100.0 * stats.statesWithMill / stats.states << "%\n  moves that close a mill: "
+                  << 100.0 * stats.millsClosed / stats.moves << "% (before choosing a capture)\n";
+    }
+    std::cout << "States by pieces on board (Light Dark count):\n";
+    for (int l = 0; l <= Position::PIECES_PER_PLAYER; ++l) {
+        for (int d = 0; d <= Position::PIECES_PER_PLAYER; ++d) {
+            if (stats.byPieces[l][d]) std::cout << "  " << l << " " << d << " " << stats.byPieces[l][d] << "\n";
+        }
+    }
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) options.threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--max-level" && hasValue) options.maxLevel = std::atoi(argv[++i]);
+        else if (arg == "--resume") options.resume = true;
+        else if (options.dir.empty() && arg[0] != '-') options.dir = arg;
+        else return false;
+    }
+    return !options.dir.empty();
+}
+
+int run(const Options& options) {
+    const std::string& dir = options.dir;
+    const uint64_t bits = PositionIndex::stateCount();
+    VisitedSet visited(dir + "/visited.bin", bits, options.resume);
+    VisitedSet discovered(dir + "/discovered.bin", bits, false);
+
+    Checkpoint checkpoint;
+    if (options.resume) {
+        checkpoint = readCheckpoint(dir);
+        std::cout << "Resuming at level " << checkpoint.level << " with " << checkpoint.stats.states
+                  << " states expanded\n";
+    } else {
+        FrontierWriter first(levelFile(dir, 0, 0));
+        first.push(PositionIndex::rankState(Position()));
+        first.flush();
+        checkpoint.files = 1;
+        checkpoint.levelSizes.push_back(1);
+        writeCheckpoint(dir, checkpoint);
+    }
+    if (!checkpoint.merged) mergeFrontier(dir, checkpoint, visited);
+    std::cout << "State space " << bits << " ranks, two bitsets of " << (visited.bytes() >> 20) << " MB mapped in "
+              << dir << ", " << options.threads << " threads\n";
+
+    const auto start = std::chrono::steady_clock::now();
+    while (checkpoint.levelSizes.back() > 0 && (options.maxLevel < 0 || checkpoint.level < options.maxLevel)) {
+        const auto levelStart = std::chrono::steady_clock::now();
+        const int level = checkpoint.level;
+        const std::vector<std::string> inputs = levelFiles(dir, checkpoint);
+        discovered.clear();
+
+        FrontierReader reader(inputs);
+        std::vector<Stats> threadStats(options.threads);
+        std::vector<uint64_t> threadWritten(options.threads);
+        std::vector<std::thread> workers;
+        std::mutex errorMutex;
+        std::string error;
+        for (unsigned t = 0; t < options.threads; ++t) {
+            workers.emplace_back([&, t] {
+                try {
+                    FrontierWriter out(levelFile(dir, level + 1, t));
+                    std::vector<uint64_t> chunk;
+                    std::vector<Move> moves;
+                    while (reader.read(chunk)) {
+                        for (uint64_t rank : chunk) {
+                            expand(PositionIndex::unrankState(rank), visited, discovered, out, moves,
+                                   threadStats[t]);
+                        }
+                    }
+                    out.flush();
+                    threadWritten[t] = out.written();
+                } catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    error = e.what();
+                }
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        if (!error.empty()) throw std::runtime_error(error);
+
+        Stats levelStats;
+        uint64_t next = 0;
+        for (unsigned t = 0; t < options.threads; ++t) {
+            levelStats.add(threadStats[t]);
+            next += threadWritten[t];
+        }
+        checkpoint.stats.add(levelStats);
+        checkpoint.level = level + 1;
+        checkpoint.files = options.threads;
+        checkpoint.merged = false;
+        checkpoint.levelSizes.push_back(next);
+        writeCheckpoint(dir, checkpoint);
+        for (const std::string& input : inputs) std::remove(input.c_str());
+        mergeFrontier(dir, checkpoint, visited);
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - levelStart).count();
+        std::cout << "level " << std::setw(3) << level << ": " << std::setw(14) << levelStats.states
+                  << " states, " << std::setw(14) << next << " new, " << std::setw(12)
+                  << static_cast<uint64_t>(rate(levelStats.moves, seconds)) << " moves/s\n";
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (checkpoint.levelSizes.back() > 0) {
+        std::cout << "Stopped before level " << checkpoint.level << " (" << checkpoint.levelSizes.back()
+                  << " states pending); continue with --resume\n";
+    }
+    printReport(checkpoint);
+    std::cout << "Elapsed " << std::fixed << std::setprecision(1) << seconds << " s\n";
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: enumerate <work-dir> [--threads N] [--max-level N] [--resume]\n";
+        return 1;
+    }
+    try {
+        return run(options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,63 @@
+#include "GameTree.h"
+#include <algorithm>
+#include <stdexcept>
+
+GameTree::GameTree(const Position& start) : current_(0) {
+    Node root;
+    root.position = start;
+    root.parent = -1;
+    root.ply = 0;
+    nodes_.push_back(root);
+}
+
+int GameTree::play(const Move& move) {
+    for (int child : nodes_[current_].children) {
+        if (nodes_[child].move == move) return current_ = child;
+    }
+    MoveError error = position().checkMove(move);
+    if (error != MoveError::NONE) throw std::runtime_error(std::string("Illegal move ") + move.toString() + ": " + moveErrorMessage(error));
+
+    Node child;
+    child.position = position();
+    child.position.makeMove(move);
+    child.move = move;
+    child.parent = current_;
+    child.ply = nodes_[current_].ply + 1;
+    nodes_.push_back(child);
+    const int id = size() - 1;
+    nodes_[current_].children.push_back(id);
+    return current_ = id;
+}
+
+bool GameTree::back() {
+    if (nodes_[current_].parent < 0) return false;
+    current_ = nodes_[current_].parent;
+    return true;
+}
+
+bool GameTree::forward(int variation) {
+    const std::vector<int>& children = nodes_[current_].children;
+    if (variation < 0 || variation >= static_cast<int>(children.size())) return false;
+    current_ = children[variation];
+    return true;
+}
+
+void GameTree::jump(int id) {
+    if (id < 0 || id >= size()) throw std::runtime_error("No such node: " + std::to_string(id));
+    current_ = id;
+}
+
+void GameTree::promote() {
+    for (int id = current_; nodes_[id].parent >= 0; id = nodes_[id].parent) {
+        std::vector<int>& siblings = nodes_[nodes_[id].parent].children;
+        std::vector<int>::iterator it = std::find(siblings.begin(), siblings.end(), id);
+        std::rotate(siblings.begin(), it, it + 1);
+    }
+}
+
+std::vector<Move> GameTree::line(int id) const {
+    std::vector<Move> moves;
+    for (; nodes_.at(id).parent >= 0; id = nodes_[id].parent) moves.push_back(nodes_[id].move);
+    std::reverse(moves.begin(), moves.end());
+    return moves;
+}
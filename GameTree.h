@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include "Position.h"
+
+// Game record as a tree of Position snapshots. Every node keeps the full compact state,
+// so taking back, stepping forward and jumping between variations never replay moves.
+class GameTree {
+public:
+    struct Node {
+        Position position;
+        Move move;              // move that led here; null at the root
+        int parent;             // -1 at the root
+        int ply;
+        std::vector<int> children;   // first child is the main line
+    };
+
+    explicit GameTree(const Position& start = Position());
+
+    const Position& position() const { return nodes_[current_].position; }
+    const Node& node(int id) const { return nodes_.at(id); }
+    int current() const { return current_; }
+    int size() const { return static_cast<int>(nodes_.size()); }
+
+    // Follows an existing child for the move or starts a new variation; throws if illegal.
+    int play(const Move& move);
+    bool back();
+    bool forward(int variation = 0);
+    void jump(int id);
+    // Makes the variation containing the current node the main line at every branch above it.
+    void promote();
+
+    std::vector<Move> line(int id) const;
+
+private:
+    std::vector<Node> nodes_;
+    int current_;
+};
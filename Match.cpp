@@ -0,0 +1,73 @@
+#include "Match.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+GameRecord playGame(const Position& start, Engine& light, const SearchLimits& lightLimits,
+                    Engine& dark, const SearchLimits& darkLimits, int maxPlies) {
+    GameRecord record;
+    record.start = start;
+    Engine* engines[2] = {&light, &dark};
+    const SearchLimits* limits[2] = {&lightLimits, &darkLimits};
+
+    Position pos = start;
+    for (int ply = 0; ply < maxPlies; ++ply) {
+        if (pos.isLost()) {
+            record.winner = 1 - pos.sideToMove();
+            return record;
+        }
+        if (pos.isDraw()) return record;
+
+        const int us = pos.sideToMove();
+        auto begin = std::chrono::steady_clock::now();
+        SearchResult result = engines[us]->search(pos, *limits[us]);
+        auto elapsed = std::chrono::steady_clock::now() - begin;
+
+        record.nodes[us] += result.nodes;
+        record.thinkMs[us] += std::chrono::duration<double, std::milli>(elapsed).count();
+        ++record.moveCount[us];
+        record.moves.push_back(result.bestMove);
+        pos.makeMove(result.bestMove);
+    }
+    return record;
+}
+
+double eloToScore(double elo) { return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0)); }
+
+double scoreToElo(double score) {
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double MatchScore::score() const {
+    return games() ? (wins + 0.5 * draws) / games() : 0.5;
+}
+
+double MatchScore::elo() const { return scoreToElo(score()); }
+
+namespace {
+
+double scoreVariance(const MatchScore& m) {
+    const double s = m.score();
+    const double n = m.games();
+    return (m.wins * (1 - s) * (1 - s) + m.draws * (0.5 - s) * (0.5 - s) + m.losses * s * s) / n;
+}
+
+}
+
+double MatchScore::eloError() const {
+    if (games() < 2) return 0;
+    double margin = 1.959964 * std::sqrt(scoreVariance(*this) / games());
+    return (scoreToElo(score() + margin) - scoreToElo(score() - margin)) / 2;
+}
+
+// Generalized SPRT on the trinomial (win/draw/loss) model, as used by fishtest.
+double MatchScore::llr(double elo0, double elo1) const {
+    int outcomes = (wins > 0) + (draws > 0) + (losses > 0);
+    if (outcomes < 2) return 0;
+    double variance = scoreVariance(*this);
+    if (variance <= 0) return 0;
+    const double s0 = eloToScore(elo0);
+    const double s1 = eloToScore(elo1);
+    return games() * (s1 - s0) * (2 * score() - s0 - s1) / (2 * variance);
+}
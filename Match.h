@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Engine.h"
+#include "Position.h"
+
+struct GameRecord {
+    Position start;
+    std::vector<Move> moves;
+    int winner = -1;               // color of the winner, -1 for a draw
+    uint64_t nodes[2] = {0, 0};
+    double thinkMs[2] = {0, 0};
+    int moveCount[2] = {0, 0};
+};
+
+// Headless game loop: the two engines alternate from start until the game ends,
+// the draw rule triggers, or maxPlies is reached (adjudicated as a draw).
+GameRecord playGame(const Position& start, Engine& light, const SearchLimits& lightLimits,
+                    Engine& dark, const SearchLimits& darkLimits, int maxPlies = 1000);
+
+struct MatchScore {
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+
+    int games() const { return wins + draws + losses; }
+    double score() const;
+    double elo() const;
+    double eloError() const;       // half-width of the 95% confidence interval
+    double llr(double elo0, double elo1) const;
+};
+
+double eloToScore(double elo);
+double scoreToElo(double score);
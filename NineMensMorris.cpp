@@ -1,18 +1,40 @@
 #include "NineMensMorris.h"
+#include "Analysis.h"
 #include <algorithm>
 #include <iostream>
 #include <limits>
 
-NineMensMorris::NineMensMorris()
+NineMensMorris::NineMensMorris(int computerColor)
     : currentPlayer_(0),
       currentPhase_(Phase::PLACING),
       board_(),
-      players_{ Player("Player 1", 0), Player("Player 2", 1) },
-      lastMovePos_(-1) {}
+      players_{ Player(computerColor == 0 ? "Computer" : "Player 1", 0),
+                Player(computerColor == 1 ? "Computer" : "Player 2", 1) },
+      lastMovePos_(-1),
+      computerColor_(computerColor),
+      gameOver_(false),
+      engine_(computerColor >= 0 ? new Engine() : nullptr),
+      ponderer_(engine_ ? new Ponderer(*engine_) : nullptr),
+      pendingRemoval_(-1) {
+    if (!engine_) return;
+    // Without a network file the computer keeps the classic evaluation.
+    try {
+        std::shared_ptr<Nnue> network = std::make_shared<Nnue>();
+        if (network->load(Nnue::DEFAULT_FILE)) engine_->setNetwork(network);
+    } catch (const std::exception& e) {
+        std::cout << "Warning: " << e.what() << ", using the classic evaluation.\n";
+    }
+}
+
+NineMensMorris::~NineMensMorris() { stopPondering(); }
 
 void NineMensMorris::startGame() {
-    while (!checkWinCondition()) {
+    while (!gameOver_ && !checkWinCondition()) {
         board_.displayBoardWithReference();
+        if (computerColor_ >= 0 && !lastComputerResult_.bestMove.isNull()) {
+            std::cout << "Computer played: " << lastComputerResult_.bestMove.toString()
+                      << " (depth " << lastComputerResult_.depth << ")\n";
+        }
         std::cout << "\nCurrent player: " << getCurrentPlayer().getName()
                   << " (" << (getCurrentPlayer().getColor() == 0 ? "Light" : "Dark") << ")\n";
 
@@ -24,30 +46,53 @@ void NineMensMorris::startGame() {
         }
         std::cout << "Action: " << action << "\n";
 
+        if (isComputerTurn()) {
+            // Not an input error: the same move would fail again, so the game cannot go on.
+            try {
+                handleComputerTurn();
+                if (gameOver_) break;
+                finishTurn();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: the computer could not play: " << e.what() << "\n";
+                stopPondering();
+                std::cout << "The game has been stopped.\n";
+                return;
+            }
+            continue;
+        }
+
         try {
+            startPondering();
             switch (currentPhase_) {
                 case Phase::PLACING: handlePlacingPhase(); break;
                 case Phase::MOVING:  handleMovingPhase(); break;
                 case Phase::FLYING:  handleFlyingPhase(); break;
             }
-
-            if (board_.isMillFormed(lastMovePos_, currentPlayer_)) {
-                handleMillFormation();
-            } else {
-                switchPlayer();
-            }
-
-            updateGamePhase();
-
+            finishTurn();
         } catch (const std::exception& e) {
             std::cerr << "Error: " << e.what() << "\n";
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         }
     }
+    stopPondering();
+    if (gameOver_) {
+        std::cout << "Computer resigns. " << players_[(computerColor_ + 1) % 2].getName()
+                  << " wins the game!\n";
+        return;
+    }
     announceWinner();
 }
 
+void NineMensMorris::finishTurn() {
+    if (board_.isMillFormed(lastMovePos_, currentPlayer_)) {
+        handleMillFormation();
+    } else {
+        switchPlayer();
+    }
+    updateGamePhase();
+}
+
 void NineMensMorris::handlePlacingPhase() {
     while (true) {
         std::cout << "Place a piece (1-24): ";
@@ -96,6 +141,54 @@ void NineMensMorris::handleFlyingPhase() {
     lastMovePos_ = to;
 }
 
+bool NineMensMorris::isComputerTurn() const { return currentPlayer_ == computerColor_; }
+
+Position NineMensMorris::toPosition() const {
+    int inHand[2] = {0, 0};
+    if (currentPhase_ == Phase::PLACING) {
+        for (int color = 0; color < 2; ++color) {
+            int onBoard = std::count(board_.getPositions().begin(), board_.getPositions().end(), color);
+            inHand[color] = std::max(0, std::min(players_[color].availableToPlace(), Position::PIECES_PER_PLAYER - onBoard));
+        }
+    }
+    return Position(board_.getPositions(), currentPlayer_, inHand[0], inHand[1]);
+}
+
+void NineMensMorris::handleComputerTurn() {
+    SearchResult result = ponderer_->search(toPosition(), COMPUTER_MOVE_TIME_MS);
+    if (result.bestMove.isNull()) {
+        gameOver_ = true;
+        return;
+    }
+
+    // The engine sees the game through toPosition(), so its move is checked against the
+    // Board and Player state like a human move; a mismatch stops the game instead of drifting.
+    const Move& move = result.bestMove;
+    if (move.isPlacement()) {
+        if (currentPhase_ != Phase::PLACING || !board_.isPositionEmpty(move.to) ||
+            !players_[currentPlayer_].placePiece(board_.getSpot(move.to))) {
+            throw std::runtime_error("Computer move " + move.toString() + " does not fit the game state");
+        }
+        board_.placePiece(currentPlayer_, move.to);
+    } else {
+        if (currentPhase_ == Phase::PLACING || !board_.isPositionOwnedBy(move.from, currentPlayer_)) {
+            throw std::runtime_error("Computer move " + move.toString() + " does not fit the game state");
+        }
+        board_.movePiece(move.from, move.to);
+    }
+    lastMovePos_ = move.to;
+    pendingRemoval_ = move.remove;
+    lastComputerResult_ = result;
+}
+
+void NineMensMorris::startPondering() {
+    if (ponderer_) ponderer_->start(toPosition(), lastComputerResult_);
+}
+
+void NineMensMorris::stopPondering() {
+    if (ponderer_) ponderer_->stop();
+}
+
 void NineMensMorris::handleMillFormation() {
     int opponentColor = (currentPlayer_ + 1) % 2;
     std::vector<int> removable = board_.getRemovableOpponentPieces(opponentColor);
@@ -105,6 +198,13 @@ void NineMensMorris::handleMillFormation() {
         return;
     }
 
+    if (isComputerTurn()) {
+        removeComputerTarget(opponentColor, removable);
+        updateGamePhase();
+        switchPlayer();
+        return;
+    }
+
     while (true) {
         std::cout << "MILL FORMED! Select opponent's piece to remove: ";
         int pos = getValidInput(1, 24) - 1;
@@ -138,6 +238,21 @@ void NineMensMorris::handleMillFormation() {
     switchPlayer();
 }
 
+// Prefers the engine's choice; falls back to the first piece the Board rules allow.
+void NineMensMorris::removeComputerTarget(int opponentColor, const std::vector<int>& removable) {
+    std::vector<int> candidates(1, pendingRemoval_);
+    candidates.insert(candidates.end(), removable.begin(), removable.end());
+    for (int pos : candidates) {
+        if (std::find(removable.begin(), removable.end(), pos) == removable.end()) continue;
+        Piece* target = board_.getSpot(pos)->getPiece();
+        if (!target || !players_[opponentColor].capturePiece(target)) continue;
+        board_.removePiece(pos);
+        players_[currentPlayer_].incrementCaptured();
+        return;
+    }
+    throw std::runtime_error("Computer could not remove any of the opponent's pieces");
+}
+
 void NineMensMorris::switchPlayer() {
     currentPlayer_ = (currentPlayer_ + 1) % 2;
 }
@@ -177,13 +292,13 @@ bool NineMensMorris::checkWinCondition() const {
 bool NineMensMorris::hasValidMoves(const Player& player) const {
     if (player.canFly()) {
         for (int i = 0; i < 24; ++i)
-            if (board_.isPositionEmpty(i)) return true;
+            if (board_.isPositionEmpty<UncheckedPolicy>(i)) return true;
     } else {
         for (const auto& piece : player.getPieces()) {
             if (piece.isPlaced()) {
                 int pos = piece.getPosition()->getPosition();
-                for (int adj : board_.getAdjacentPositions(pos))
-                    if (board_.isPositionEmpty(adj)) return true;
+                for (int adj : board_.getAdjacentPositions<UncheckedPolicy>(pos))
+                    if (board_.isPositionEmpty<UncheckedPolicy>(adj)) return true;
             }
         }
     }
@@ -195,7 +310,10 @@ int NineMensMorris::getValidInput(int min, int max) {
     while (true) {
         std::string inputStr;
         std::cin >> inputStr;
-        if (inputStr == "exit") std::exit(0);
+        if (inputStr == "exit") {
+            stopPondering();
+            std::exit(0);
+        }
 
         try {
             input = std::stoi(inputStr);
@@ -221,8 +339,10 @@ int main() {
     while (true) {
         std::cout << "==================== NINE MEN'S MORRIS ====================\n";
         std::cout << "1. Start Game\n";
-        std::cout << "2. Exit\n";
-        std::cout << "Choose a section please (1 or 2): ";
+        std::cout << "2. Play vs Computer\n";
+        std::cout << "3. Analysis Board\n";
+        std::cout << "4. Exit\n";
+        std::cout << "Choose a section please (1, 2, 3 or 4): ";
 
         std::string choiceStr;
         std::cin >> choiceStr;
@@ -231,9 +351,15 @@ int main() {
             NineMensMorris game;
             game.startGame();
         } else if (choiceStr == "2") {
+            NineMensMorris game(1);
+            game.startGame();
+        } else if (choiceStr == "3") {
+            AnalysisBoard board;
+            board.run();
+        } else if (choiceStr == "4") {
             break;
         } else {
-            std::cout << "Invalid input. Please choose section 1 or 2.\n";
+            std::cout << "Invalid input. Please choose section 1, 2, 3 or 4.\n";
         }
     }
     return 0;
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include "Board.h"
+#include "Engine.h"
+#include "Ponderer.h"
 #include "Player.h"
 #include "Piece.h"
 
@@ -13,7 +16,10 @@ public:
         FLYING 
     };
 
-    NineMensMorris();     
+    static const int COMPUTER_MOVE_TIME_MS = 1000;
+
+    explicit NineMensMorris(int computerColor = -1);
+    ~NineMensMorris();
     void startGame();       
     void saveGameToFile(const std::string& filename);
     void loadGameFromFile(const std::string& filename);
@@ -24,14 +30,27 @@ private:
     Board board_;             
     Player players_[2];           
     int lastMovePos_;
+    int computerColor_;
+    bool gameOver_;
+    std::unique_ptr<Engine> engine_;
+    std::unique_ptr<Ponderer> ponderer_;
+    SearchResult lastComputerResult_;
+    int pendingRemoval_;
 
     void handlePlacingPhase();
     void handleMovingPhase();
     void handleFlyingPhase();
+    void handleComputerTurn();
+    bool isComputerTurn() const;
+    Position toPosition() const;
+    void startPondering();
+    void stopPondering();
+    void finishTurn();
     bool checkWinCondition() const;
     void updateGamePhase();
     void switchPlayer();
     void handleMillFormation();
+    void removeComputerTarget(int opponentColor, const std::vector<int>& removable);
     bool hasValidMoves(const Player& player) const;
     int getValidInput(int min, int max);
     void displayBoard() const;
@@ -2,9 +2,25 @@
 #include "Board.h"
 #include "Player.h"
 #include "Spot.h"
+#include "Position.h"
+#include "Engine.h"
+#include "Nnue.h"
+#include "Match.h"
+#include "PositionIndex.h"
+#include "ResultTable.h"
+#include "GameTree.h"
+#include "Ponderer.h"
 #include <iostream>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
 
 #define TEST_CASE(name) std::cout << "Test: " << name << "... ";
 #define PASSED() std::cout << "Passed\n"
@@ -181,6 +197,395 @@ void testMovingToFlyingPhase(){
     PASSED();
 }
 
+void testMoveNotation(){
+    TEST_CASE("Move Notation Round Trip");
+    for (const char* text : {"7", "7-8", "7x3", "10-11x24"})
+        assert(Move::fromString(text).toString() == text);
+    try {
+        Move::fromString("25");
+        FAILED();
+    } catch (const std::runtime_error&) {
+        PASSED();
+    }
+}
+
+void testPositionMillCapture(){
+    TEST_CASE("Position Mill Capture");
+    Position position;
+    for (const char* text : {"1", "4", "2", "5"})
+        position.makeMove(Move::fromString(text));
+
+    std::vector<Move> moves;
+    position.generateMoves(moves);
+    int captures = 0;
+    for (const Move& move : moves)
+        if (move.to == 2) { assert(move.isCapture()); ++captures; }
+    assert(captures == 2);
+
+    position.makeMove(Move::fromString("3x4"));
+    assert(position.pieceAt(3) == -1 && position.piecesOnBoard(1) == 1);
+    assert(Position::fromString(position.toString()).key() == position.key());
+    PASSED();
+}
+
+void testPositionCheckMove(){
+    TEST_CASE("Position Check Move");
+    Position placing;
+    for (const char* text : {"1", "4", "2", "5"})
+        placing.makeMove(Move::fromString(text));
+    assert(placing.checkMove(Move::fromString("3")) == MoveError::MISSING_CAPTURE);
+    assert(placing.checkMove(Move::fromString("3x1")) == MoveError::NOT_OPPONENT_PIECE);
+    assert(placing.checkMove(Move::fromString("6x4")) == MoveError::UNEXPECTED_CAPTURE);
+    assert(placing.checkMove(Move::fromString("4")) == MoveError::OCCUPIED);
+    assert(placing.checkMove(Move::fromString("1-3")) == MoveError::WRONG_PHASE);
+    assert(placing.checkMove(Move(-1, 30)) == MoveError::INVALID_POINT);
+
+    Position moving = Position::fromString("OO.XXX.X..O...O......... O 0 0");
+    assert(moving.checkMove(Move::fromString("15-3x8")) == MoveError::NONE);
+    assert(moving.checkMove(Move::fromString("15-3x4")) == MoveError::PROTECTED_PIECE);
+    assert(moving.checkMove(Move::fromString("15-3")) == MoveError::MISSING_CAPTURE);
+    assert(moving.checkMove(Move::fromString("11-13")) == MoveError::NOT_ADJACENT);
+    assert(moving.checkMove(Move::fromString("10-12")) == MoveError::NOT_OWN_PIECE);
+    assert(moving.checkMove(Move::fromString("7")) == MoveError::WRONG_PHASE);
+
+    Move move;
+    assert(Move::parse("7-8x3", std::strchr("7-8x3", 0), move) && move == Move(6, 7, 2));
+    assert(!Move::parse("7-", std::strchr("7-", 0), move));
+
+    // Every generated move must pass the direct check.
+    Position position;
+    std::vector<Move> moves;
+    for (int ply = 0; ply < 120 && !position.isGameOver(); ++ply){
+        position.generateMoves(moves);
+        for (const Move& candidate : moves)
+            assert(position.isLegal(candidate));
+        position.makeMove(moves[(ply * 13) % moves.size()]);
+    }
+    PASSED();
+}
+
+void testEngineClosesMill(){
+    TEST_CASE("Engine Closes Mill");
+    Position position = Position::fromString("OO.XX................... O 7 7");
+    Engine engine(1 << 12);
+    SearchResult result = engine.search(position, SearchLimits(3));
+    assert(result.bestMove.to == 2 && result.bestMove.isCapture());
+    PASSED();
+}
+
+void testEngineStopFlag(){
+    TEST_CASE("Engine Stops On Request");
+    Engine engine(1 << 16);
+    std::atomic<bool> stop(true);
+    SearchResult result = engine.search(Position(), SearchLimits(Engine::MAX_PLY, 0, 0, &stop));
+    assert(result.depth == 0 && result.nodes <= 1);
+    assert(Position().isLegal(result.bestMove));
+
+    // Raised from another thread, the flag ends a search that would otherwise run to MAX_PLY.
+    stop = false;
+    std::thread ponder([&] { result = engine.search(Position(), SearchLimits(Engine::MAX_PLY, 0, 0, &stop)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stop = true;
+    ponder.join();
+    assert(result.depth < Engine::MAX_PLY && Position().isLegal(result.bestMove));
+    PASSED();
+}
+
+void testPonderHit(){
+    TEST_CASE("Ponder Hit");
+    Engine engine(1 << 16);
+    Ponderer ponderer(engine);
+    Position position;
+    position.makeMove(Move::fromString("1"));
+
+    // Pondered past the move time: the pondered result is played as is.
+    ponderer.start(position, SearchResult());
+    assert(ponderer.isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    SearchResult result = ponderer.search(position, 10);
+    assert(ponderer.lastSearchWasHit() && !ponderer.isRunning());
+    assert(result.depth > 0 && position.isLegal(result.bestMove));
+
+    // The last PV predicts the reply; a hit tops the search up to the move time.
+    SearchResult last;
+    last.pv = {Move::fromString("2"), Move::fromString("3")};
+    Position predicted = position;
+    predicted.makeMove(last.pv[1]);
+    ponderer.start(position, last);
+    result = ponderer.search(predicted, 20);
+    assert(ponderer.lastSearchWasHit() && predicted.isLegal(result.bestMove));
+
+    // Any other reply is a miss and gets a search of its own.
+    ponderer.start(position, last);
+    Position other = position;
+    other.makeMove(Move::fromString("24"));
+    result = ponderer.search(other, 20);
+    assert(!ponderer.lastSearchWasHit() && other.isLegal(result.bestMove));
+    assert(ponderer.stop() == -1);
+    PASSED();
+}
+
+// Every reported line must carry the exact score of its own move, in order.
+void checkMultiPv(const Position& position, int depth, std::size_t count){
+    Engine engine(1 << 12);
+    std::vector<SearchResult> lines = engine.searchMultiPv(position, SearchLimits(depth), static_cast<int>(count));
+    assert(lines.size() == count);
+
+    std::vector<Move> moves;
+    position.generateMoves(moves);
+    std::vector<int> exact;
+    for (const Move& move : moves){
+        Position child = position;
+        child.makeMove(move);
+        Engine reference(1 << 12);
+        int score = -reference.search(child, SearchLimits(depth - 1)).score;
+        // The reference counts forced wins from the child, one ply later.
+        if (Engine::isWinScore(score)) score += score > 0 ? -1 : 1;
+        exact.push_back(score);
+        for (const SearchResult& line : lines)
+            if (line.bestMove == move) assert(line.score == exact.back());
+    }
+    std::sort(exact.begin(), exact.end(), std::greater<int>());
+    for (std::size_t i = 0; i < lines.size(); ++i){
+        assert(lines[i].depth == depth && lines[i].score == exact[i]);
+        assert(lines[i].pv.front() == lines[i].bestMove && position.isLegal(lines[i].bestMove));
+        for (std::size_t j = 0; j < i; ++j) assert(lines[j].bestMove != lines[i].bestMove);
+    }
+    assert(engine.search(position, SearchLimits(depth)).score == lines.front().score);
+}
+
+void testEngineMultiPv(){
+    TEST_CASE("Engine Multi-PV");
+    // Quiet positions have many root moves with equal scores, so ties at the cut-off occur.
+    Position position;
+    std::vector<Move> moves;
+    for (int ply = 0; ply < 30; ++ply){
+        checkMultiPv(position, 3, 4);
+        position.generateMoves(moves);
+        position.makeMove(moves[(ply * 7) % moves.size()]);
+    }
+    // Some moves lose by force here; the search must go on while better lines are unresolved.
+    Position flying = Position::fromString("XX.X.....X.OX.X....O.XXO O 0 0 8");
+    flying.generateMoves(moves);
+    checkMultiPv(flying, 3, moves.size());
+
+    // Stopped before depth 1 completes, it still reports the first moves, like search().
+    std::atomic<bool> stop(true);
+    Engine engine(1 << 12);
+    std::vector<SearchResult> lines = engine.searchMultiPv(Position(), SearchLimits(Engine::MAX_PLY, 0, 0, &stop), 3);
+    assert(lines.size() == 3 && lines[0].bestMove != lines[1].bestMove);
+    for (const SearchResult& line : lines) assert(line.depth == 0 && Position().isLegal(line.bestMove));
+    PASSED();
+}
+
+void testGameTreeNavigation(){
+    TEST_CASE("Game Tree Navigation");
+    GameTree tree;
+    int a = tree.play(Move::fromString("7"));
+    int b = tree.play(Move::fromString("8"));
+    assert(tree.back() && tree.current() == a);
+    int c = tree.play(Move::fromString("9"));
+    assert(c != b && tree.node(a).children.size() == 2);
+    assert(tree.back() && tree.play(Move::fromString("8")) == b && tree.size() == 4);
+
+    tree.jump(c);
+    assert(tree.position().pieceAt(8) == 1 && tree.position().pieceAt(7) == -1);
+    assert(tree.line(c).size() == 2 && tree.line(c)[1] == Move::fromString("9"));
+    tree.promote();
+    assert(tree.node(a).children.front() == c);
+    tree.jump(0);
+    assert(tree.forward() && tree.forward() && tree.current() == c);
+    assert(!tree.forward() && tree.back() && tree.back() && !tree.back());
+
+    bool threw = false;
+    try { tree.play(Move::fromString("7-8")); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw && tree.current() == 0 && tree.size() == 4);
+    PASSED();
+}
+
+void testFlyingMovePiece(){
+    TEST_CASE("Flying Move Piece");
+    Board board;
+    Player player("Test", 0);
+    for (int pos : {0, 3, 6}){
+        player.placePiece(board.getSpot(pos));
+        board.placePiece(0, pos);
+    }
+    board.movePiece(0, 23);
+    assert(board.isPositionOwnedBy(23, 0) && board.isPositionEmpty(0));
+    PASSED();
+}
+
+void testNnueIncrementalUpdate(){
+    TEST_CASE("NNUE Incremental Update");
+    Nnue network;
+    assert(!network.load("missing_network.bin"));
+    network.randomize(3);
+    network.save("test_network.bin");
+    std::shared_ptr<Nnue> loaded = std::make_shared<Nnue>();
+    assert(loaded->load("test_network.bin"));
+    std::remove("test_network.bin");
+
+    Position position;
+    Nnue::Accumulator accumulator, refreshed;
+    loaded->refresh(position, accumulator);
+    std::vector<Move> moves;
+    for (int ply = 0; ply < 80 && !position.isGameOver(); ++ply){
+        position.generateMoves(moves);
+        Move move = moves[(ply * 5) % moves.size()];
+        for (const Move& capture : moves)
+            if (capture.isCapture()) { move = capture; break; }
+        Nnue::Accumulator child;
+        loaded->update(accumulator, position, move, child);
+        position.makeMove(move);
+        accumulator = child;
+        loaded->refresh(position, refreshed);
+        assert(std::equal(&accumulator.values[0][0], &accumulator.values[0][0] + 2 * Nnue::HIDDEN, &refreshed.values[0][0]));
+        assert(loaded->evaluate(accumulator, position.sideToMove()) == network.evaluate(position));
+    }
+
+    Engine engine(1 << 12);
+    engine.setNetwork(loaded);
+    SearchResult result = engine.search(Position(), SearchLimits(4));
+    assert(engine.hasNetwork() && Position().isLegal(result.bestMove));
+    PASSED();
+}
+
+void testHeadlessGame(){
+    TEST_CASE("Headless Game Loop");
+    Engine light(1 << 12), dark(1 << 12);
+    GameRecord game = playGame(Position(), light, SearchLimits(3), dark, SearchLimits(1));
+    Position position = game.start;
+    for (const Move& move : game.moves){
+        assert(position.isLegal(move));
+        position.makeMove(move);
+    }
+    assert(game.winner == -1 ? position.isDraw() || game.moves.size() == 1000 : position.isLost());
+    assert(game.moveCount[0] + game.moveCount[1] == static_cast<int>(game.moves.size()));
+    PASSED();
+}
+
+void testSprtStatistics(){
+    TEST_CASE("SPRT Statistics");
+    MatchScore even;
+    even.wins = even.losses = 40;
+    even.draws = 20;
+    assert(std::abs(even.elo()) < 1e-9 && even.eloError() > 0);
+    assert(even.llr(0, 10) < 0);
+
+    MatchScore strong;
+    strong.wins = 70;
+    strong.draws = 20;
+    strong.losses = 10;
+    assert(strong.elo() > 100 && strong.llr(0, 10) > 0);
+    assert(std::abs(scoreToElo(eloToScore(42.0)) - 42.0) < 1e-6);
+    PASSED();
+}
+
+void testBoardStatusCodes(){
+    TEST_CASE("Board Status Codes");
+    Board board;
+    assert(board.tryPlacePiece(0, 24) == BoardStatus::INVALID_POSITION);
+    assert(board.tryPlacePiece(0, 0) == BoardStatus::OK);
+    assert(board.tryPlacePiece(1, 0) == BoardStatus::POSITION_OCCUPIED);
+    assert(board.tryMovePiece(5, 6) == BoardStatus::SOURCE_EMPTY);
+    assert(board.tryMovePiece(0, 5) == BoardStatus::NOT_ADJACENT);
+    assert(board.tryRemovePiece(7) == BoardStatus::NOTHING_TO_REMOVE);
+    assert(std::string(Board::statusMessage(BoardStatus::POSITION_OCCUPIED)) == "Position already occupied");
+    try {
+        board.placePiece(0, -1);
+        FAILED();
+    } catch (const std::out_of_range&) {
+        PASSED();
+    }
+}
+
+void testUncheckedBoardOperations(){
+    TEST_CASE("Unchecked Board Operations");
+    Board board;
+    Player player("Test", 0);
+    player.placePiece(board.getSpot<UncheckedPolicy>(0));
+    board.tryPlacePiece<UncheckedPolicy>(0, 0);
+    board.tryMovePiece<UncheckedPolicy>(0, 1);
+    assert(board.isPositionOwnedBy<UncheckedPolicy>(1, 0) && board.isPositionEmpty<UncheckedPolicy>(0));
+    assert(board.getSpot<UncheckedPolicy>(1)->getPiece() == &player.getPieces()[0]);
+    board.tryRemovePiece<UncheckedPolicy>(1);
+    assert(board.isPositionEmpty(1) && player.activePieces() == 0);
+    static_assert(noexcept(board.isAdjacent<UncheckedPolicy>(0, 1)), "unchecked accessors must be noexcept");
+    PASSED();
+}
+
+void testPositionIndexRoundTrip(){
+    TEST_CASE("Position Index Round Trip");
+    assert(PositionIndex::subspaceSize(9, 9) == 1307504ull * 5005ull);
+    const uint64_t size = PositionIndex::subspaceSize(3, 2);
+    for (uint64_t index = 0; index < size; index += 997){
+        uint32_t light, dark;
+        PositionIndex::unrank(index, 3, 2, light, dark);
+        assert(popCount(light) == 3 && popCount(dark) == 2 && !(light & dark));
+        assert(PositionIndex::rank(light, dark) == index);
+    }
+    Position position = Position::fromString("OOO.XX.................. O 0 0");
+    assert(PositionIndex::rank(position.getPositions()) == PositionIndex::rank(position.occupancy(0), position.occupancy(1)));
+    PASSED();
+}
+
+void testStateIndexRoundTrip(){
+    TEST_CASE("State Index Round Trip");
+    Position position;
+    std::vector<Move> moves;
+    std::vector<uint64_t> seen;
+    for (int ply = 0; ply < 40 && !position.isGameOver(); ++ply){
+        uint64_t index = PositionIndex::rankState(position);
+        assert(index < PositionIndex::stateCount());
+        Position restored = PositionIndex::unrankState(index);
+        assert(restored.occupancy(0) == position.occupancy(0) && restored.occupancy(1) == position.occupancy(1));
+        assert(restored.sideToMove() == position.sideToMove());
+        assert(restored.piecesInHand(0) == position.piecesInHand(0) && restored.piecesInHand(1) == position.piecesInHand(1));
+        if (position.piecesInHand(1) > 0) seen.push_back(index);
+        position.generateMoves(moves);
+        position.makeMove(moves[(ply * 7) % moves.size()]);
+    }
+    std::sort(seen.begin(), seen.end());
+    assert(std::unique(seen.begin(), seen.end()) == seen.end());
+    PASSED();
+}
+
+void testResultTableRoundTrip(){
+    TEST_CASE("Result Table Round Trip");
+    const uint64_t size = PositionIndex::subspaceSize(2, 2);
+    {
+        std::ofstream raw("test_table.raw", std::ios::binary);
+        for (uint64_t index = 0; index < size; ++index)
+            raw.put(static_cast<char>((index / 1000) % 3 == 0 ? index % 4 : 0));
+    }
+    ResultTable::convertRaw("test_table.raw", "test_table.mtb", 2, 2, 0, 256);
+    {
+        ResultTable table("test_table.mtb", 4);
+        assert(table.size() == size && table.blockCount() == (size + 255) / 256 && table.blockPositions() == 256);
+        for (uint64_t index = 0; index < size; index += 7)
+            assert(static_cast<uint64_t>(table.probe(index)) == ((index / 1000) % 3 == 0 ? index % 4 : 0));
+        assert(table.cacheMisses() > 0 && table.cacheHits() > 0);
+
+        std::vector<int> board(Position::NUM_POINTS, -1);
+        board[0] = board[1] = 0;
+        board[5] = board[9] = 1;
+        assert(table.probe(board) == table.probe(PositionIndex::rank(board)));
+        board[12] = 1;
+        assert(table.probe(board) == TableResult::UNKNOWN);
+        assert(table.probe(Position(board, 0, 0, 0)) == TableResult::UNKNOWN);
+
+        // Same counts on the board, but still placing: not a position the table holds.
+        board[12] = -1;
+        assert(table.probe(Position(board, 0, 0, 0)) == table.probe(board));
+        assert(table.probe(Position(board, 0, 7, 7)) == TableResult::UNKNOWN);
+        assert(table.probe(Position(board, 0, 0, 1)) == TableResult::UNKNOWN);
+    }
+    std::remove("test_table.raw");
+    std::remove("test_table.mtb");
+    PASSED();
+}
+
 int main() {
     std::cout << "=== NINE MEN'S MORRIS TEST SUITE ===\n\n";
 
@@ -195,6 +600,23 @@ int main() {
     testWinContditionSimulation();
     testPlacingToMovingPhase();
     testMovingToFlyingPhase();
+    testMoveNotation();
+    testPositionMillCapture();
+    testPositionCheckMove();
+    testEngineClosesMill();
+    testEngineStopFlag();
+    testPonderHit();
+    testEngineMultiPv();
+    testGameTreeNavigation();
+    testFlyingMovePiece();
+    testNnueIncrementalUpdate();
+    testHeadlessGame();
+    testSprtStatistics();
+    testBoardStatusCodes();
+    testUncheckedBoardOperations();
+    testPositionIndexRoundTrip();
+    testStateIndexRoundTrip();
+    testResultTableRoundTrip();
 
     std::cout << "\nAll tests completed!\n";
     return 0;
@@ -0,0 +1,248 @@
+#include "Nnue.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const char MAGIC[8] = {'N', 'M', 'M', 'N', 'N', 'U', 'E', '1'};
+const int ACTIVATION_MAX = 127;   // 1.0 after clipping
+const int DENSE_SHIFT = 6;        // dense weights are scaled by 64
+const int OUTPUT_DIVISOR = 16;
+
+void writeInt(std::ostream& out, uint64_t value, int bytes) {
+    char buffer[8];
+    for (int i = 0; i < bytes; ++i) buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    out.write(buffer, bytes);
+}
+
+uint64_t readInt(std::istream& in, int bytes) {
+    unsigned char buffer[8];
+    if (!in.read(reinterpret_cast<char*>(buffer), bytes)) throw std::runtime_error("Truncated network file");
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+    return value;
+}
+
+template <typename T>
+void writeArray(std::ostream& out, const T* values, int count) {
+    for (int i = 0; i < count; ++i) writeInt(out, static_cast<uint64_t>(values[i]), sizeof(T));
+}
+
+template <typename T>
+void readArray(std::istream& in, T* values, int count) {
+    for (int i = 0; i < count; ++i) values[i] = static_cast<T>(readInt(in, sizeof(T)));
+}
+
+void addRow(int16_t* values, const int16_t* row) {
+#if defined(__AVX2__)
+    for (int i = 0; i < Nnue::HIDDEN; i += 16) {
+        __m256i sum = _mm256_add_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)),
+                                       _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), sum);
+    }
+#else
+    for (int i = 0; i < Nnue::HIDDEN; ++i) values[i] = static_cast<int16_t>(values[i] + row[i]);
+#endif
+}
+
+void subRow(int16_t* values, const int16_t* row) {
+#if defined(__AVX2__)
+    for (int i = 0; i < Nnue::HIDDEN; i += 16) {
+        __m256i diff = _mm256_sub_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)),
+                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), diff);
+    }
+#else
+    for (int i = 0; i < Nnue::HIDDEN; ++i) values[i] = static_cast<int16_t>(values[i] - row[i]);
+#endif
+}
+
+// Clipped ReLU of both accumulator rows, side to move first, into 0..127 bytes.
+void clipAccumulator(const Nnue::Accumulator& acc, int sideToMove, uint8_t* out) {
+    const int16_t* rows[2] = {acc.values[sideToMove], acc.values[1 - sideToMove]};
+    for (int half = 0; half < 2; ++half) {
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i top = _mm256_set1_epi16(ACTIVATION_MAX);
+        for (int i = 0; i < Nnue::HIDDEN; i += 32) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[half] + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows[half] + i + 16));
+            a = _mm256_max_epi16(_mm256_min_epi16(a, top), zero);
+            b = _mm256_max_epi16(_mm256_min_epi16(b, top), zero);
+            // packus interleaves the 128-bit lanes; the permute restores element order.
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + half * Nnue::HIDDEN + i), packed);
+        }
+#else
+        for (int i = 0; i < Nnue::HIDDEN; ++i) {
+            out[half * Nnue::HIDDEN + i] =
+                static_cast<uint8_t>(std::min<int>(ACTIVATION_MAX, std::max<int>(0, rows[half][i])));
+        }
+#endif
+    }
+}
+
+// Dot product of unsigned activations (at most 127) with signed weights. Pair sums stay
+// within int16, so maddubs never saturates and both paths give the same result.
+int32_t dot(const uint8_t* input, const int8_t* weights, int count) {
+#if defined(__AVX2__)
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < count; i += 32) {
+        __m256i products = _mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)),
+                                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i)));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+    }
+    __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+    half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+    return _mm_cvtsi128_si32(half);
+#else
+    int32_t sum = 0;
+    for (int i = 0; i < count; ++i) sum += static_cast<int32_t>(input[i]) * weights[i];
+    return sum;
+#endif
+}
+
+}
+
+Nnue::Nnue() : outputBias_(0) {
+    std::memset(featureWeights_, 0, sizeof(featureWeights_));
+    std::memset(featureBias_, 0, sizeof(featureBias_));
+    std::memset(denseWeights_, 0, sizeof(denseWeights_));
+    std::memset(denseBias_, 0, sizeof(denseBias_));
+    std::memset(outputWeights_, 0, sizeof(outputWeights_));
+}
+
+int Nnue::pieceFeature(int perspective, int color, int pos) {
+    return (color == perspective ? 0 : Position::NUM_POINTS) + pos;
+}
+
+int Nnue::handFeature(int perspective, int color, int count) {
+    return 2 * Position::NUM_POINTS + (color == perspective ? 0 : HAND_COUNTS) + count;
+}
+
+const char* Nnue::instructionSet() {
+#if defined(__AVX2__)
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+
+bool Nnue::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) return false;
+    char magic[8];
+    if (!in.read(magic, 8) || std::memcmp(magic, MAGIC, 8) != 0) {
+        throw std::runtime_error("Not a network file: " + filename);
+    }
+    if (readInt(in, 4) != FEATURES || readInt(in, 4) != HIDDEN || readInt(in, 4) != DENSE) {
+        throw std::runtime_error("Network layout does not match this build: " + filename);
+    }
+    readArray(in, &featureWeights_[0][0], FEATURES * HIDDEN);
+    readArray(in, featureBias_, HIDDEN);
+    readArray(in, &denseWeights_[0][0], DENSE * 2 * HIDDEN);
+    readArray(in, denseBias_, DENSE);
+    readArray(in, outputWeights_, DENSE);
+    readArray(in, &outputBias_, 1);
+    return true;
+}
+
+void Nnue::save(const std::string& filename) const {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(MAGIC, 8);
+    writeInt(out, FEATURES, 4);
+    writeInt(out, HIDDEN, 4);
+    writeInt(out, DENSE, 4);
+    writeArray(out, &featureWeights_[0][0], FEATURES * HIDDEN);
+    writeArray(out, featureBias_, HIDDEN);
+    writeArray(out, &denseWeights_[0][0], DENSE * 2 * HIDDEN);
+    writeArray(out, denseBias_, DENSE);
+    writeArray(out, outputWeights_, DENSE);
+    writeArray(out, &outputBias_, 1);
+    if (!out) throw std::runtime_error("Cannot write " + filename);
+}
+
+// Small random weights, so the whole pipeline can be exercised before a trained network exists.
+void Nnue::randomize(uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto uniform = [&rng](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+    for (auto& row : featureWeights_) {
+        for (auto& weight : row) weight = static_cast<int16_t>(uniform(-24, 24));
+    }
+    for (auto& bias : featureBias_) bias = static_cast<int16_t>(uniform(0, 32));
+    for (auto& row : denseWeights_) {
+        for (auto& weight : row) weight = static_cast<int8_t>(uniform(-16, 16));
+    }
+    for (auto& bias : denseBias_) bias = uniform(0, 512);
+    for (auto& weight : outputWeights_) weight = static_cast<int8_t>(uniform(-32, 32));
+    outputBias_ = 0;
+}
+
+void Nnue::refresh(const Position& pos, Accumulator& acc) const {
+    for (int perspective = 0; perspective < 2; ++perspective) {
+        int16_t* values = acc.values[perspective];
+        std::memcpy(values, featureBias_, sizeof(featureBias_));
+        for (int color = 0; color < 2; ++color) {
+            for (uint32_t bits = pos.occupancy(color); bits; bits &= bits - 1) {
+                addRow(values, featureWeights_[pieceFeature(perspective, color, lowestBit(bits))]);
+            }
+            addRow(values, featureWeights_[handFeature(perspective, color, pos.piecesInHand(color))]);
+        }
+    }
+}
+
+void Nnue::placePiece(Accumulator& acc, int color, int pos, int inHand) const {
+    for (int perspective = 0; perspective < 2; ++perspective) {
+        int16_t* values = acc.values[perspective];
+        addRow(values, featureWeights_[pieceFeature(perspective, color, pos)]);
+        subRow(values, featureWeights_[handFeature(perspective, color, inHand)]);
+        addRow(values, featureWeights_[handFeature(perspective, color, inHand - 1)]);
+    }
+}
+
+void Nnue::movePiece(Accumulator& acc, int color, int from, int to) const {
+    for (int perspective = 0; perspective < 2; ++perspective) {
+        subRow(acc.values[perspective], featureWeights_[pieceFeature(perspective, color, from)]);
+        addRow(acc.values[perspective], featureWeights_[pieceFeature(perspective, color, to)]);
+    }
+}
+
+void Nnue::removePiece(Accumulator& acc, int color, int pos) const {
+    for (int perspective = 0; perspective < 2; ++perspective) {
+        subRow(acc.values[perspective], featureWeights_[pieceFeature(perspective, color, pos)]);
+    }
+}
+
+void Nnue::update(const Accumulator& parent, const Position& before, const Move& move, Accumulator& child) const {
+    const int us = before.sideToMove();
+    child = parent;
+    if (move.isPlacement()) placePiece(child, us, move.to, before.piecesInHand(us));
+    else movePiece(child, us, move.from, move.to);
+    if (move.isCapture()) removePiece(child, 1 - us, move.remove);
+}
+
+int Nnue::evaluate(const Accumulator& acc, int sideToMove) const {
+    uint8_t input[2 * HIDDEN];
+    clipAccumulator(acc, sideToMove, input);
+
+    uint8_t hidden[DENSE];
+    for (int i = 0; i < DENSE; ++i) {
+        int32_t sum = (denseBias_[i] + dot(input, denseWeights_[i], 2 * HIDDEN)) >> DENSE_SHIFT;
+        hidden[i] = static_cast<uint8_t>(std::min(ACTIVATION_MAX, std::max(0, sum)));
+    }
+    return (outputBias_ + dot(hidden, outputWeights_, DENSE)) / OUTPUT_DIVISOR;
+}
+
+int Nnue::evaluate(const Position& pos) const {
+    Accumulator acc;
+    refresh(pos, acc);
+    return evaluate(acc, pos.sideToMove());
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "Position.h"
+
+// Small quantized evaluation network. The first layer is a sparse accumulator over
+// (point, color) and pieces-in-hand features, kept for both perspectives and updated
+// incrementally as pieces are placed, moved and removed; the dense layers run on
+// int8/int16 with AVX2 when the build enables it and a scalar loop otherwise.
+class Nnue {
+public:
+    static const int HAND_COUNTS = Position::PIECES_PER_PLAYER + 1;
+    static const int FEATURES = 2 * Position::NUM_POINTS + 2 * HAND_COUNTS;
+    static const int HIDDEN = 64;
+    static const int DENSE = 32;
+    // Loaded from the working directory by the game and the analysis board when present.
+    static constexpr const char* DEFAULT_FILE = "nnue.bin";
+
+    // First-layer sums, one row per perspective (color).
+    struct Accumulator {
+        int16_t values[2][HIDDEN];
+    };
+
+    Nnue();
+
+    // Returns false if the file does not exist; throws if it is not a valid network.
+    bool load(const std::string& filename);
+    void save(const std::string& filename) const;
+    void randomize(uint32_t seed);
+
+    void refresh(const Position& pos, Accumulator& acc) const;
+    // Mirrors Board::placePiece/movePiece/removePiece; inHand is the count before placing.
+    void placePiece(Accumulator& acc, int color, int pos, int inHand) const;
+    void movePiece(Accumulator& acc, int color, int from, int to) const;
+    void removePiece(Accumulator& acc, int color, int pos) const;
+    void update(const Accumulator& parent, const Position& before, const Move& move, Accumulator& child) const;
+
+    // Score in the classic evaluation's units, from the side to move's point of view.
+    int evaluate(const Accumulator& acc, int sideToMove) const;
+    int evaluate(const Position& pos) const;
+
+    static int pieceFeature(int perspective, int color, int pos);
+    static int handFeature(int perspective, int color, int count);
+    static const char* instructionSet();
+
+private:
+    int16_t featureWeights_[FEATURES][HIDDEN];
+    int16_t featureBias_[HIDDEN];
+    int8_t denseWeights_[DENSE][2 * HIDDEN];
+    int32_t denseBias_[DENSE];
+    int8_t outputWeights_[DENSE];
+    int32_t outputBias_;
+};
@@ -0,0 +1,209 @@
+#include "Engine.h"
+#include "Nnue.h"
+#include "Position.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int intOption(int argc, char* argv[], const std::string& name, int fallback) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (name == argv[i]) return std::atoi(argv[i + 1]);
+    }
+    return fallback;
+}
+
+std::string stringOption(int argc, char* argv[], const std::string& name) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (name == argv[i]) return argv[i + 1];
+    }
+    return "";
+}
+
+void usage() {
+    std::cerr << "Usage: nnuetool init <weights> [--seed N]\n"
+                 "       nnuetool export <samples.tsv> [--games N] [--nodes N] [--random-plies N] [--seed N]\n"
+                 "                       [--threads N] [--nnue WEIGHTS]\n"
+                 "       nnuetool bench [--nnue WEIGHTS] [--positions N] [--seed N]\n";
+}
+
+std::shared_ptr<const Nnue> loadNetwork(const std::string& filename) {
+    if (filename.empty()) return nullptr;
+    std::shared_ptr<Nnue> network = std::make_shared<Nnue>();
+    if (!network->load(filename)) throw std::runtime_error("Cannot open " + filename);
+    return network;
+}
+
+// Plays one self-play game and appends "<position>\t<score>\t<result>" per searched
+// position; score and result (1 win, 0 draw, -1 loss) are for the side to move.
+void exportGame(Engine& engine, const SearchLimits& limits, int randomPlies, std::mt19937& rng, std::string& out) {
+    Position pos;
+    std::vector<Move> moves;
+    for (int ply = 0; ply < randomPlies && !pos.isGameOver(); ++ply) {
+        pos.generateMoves(moves);
+        pos.makeMove(moves[rng() % moves.size()]);
+    }
+
+    engine.clear();
+    std::vector<std::pair<Position, int>> samples;
+    // Self-play is adjudicated a draw after DRAW_PLY_LIMIT plies without a capture.
+    for (int ply = 0; ply < 400 && !pos.isGameOver() && !pos.isDraw(); ++ply) {
+        SearchResult result = engine.search(pos, limits);
+        samples.push_back(std::make_pair(pos, result.score));
+        pos.makeMove(result.bestMove);
+    }
+    const int loser = pos.isLost() ? pos.sideToMove() : -1;
+    for (const auto& sample : samples) {
+        int result = loser < 0 ? 0 : (sample.first.sideToMove() == loser ? -1 : 1);
+        out += sample.first.toString() + "\t" + std::to_string(sample.second) + "\t" + std::to_string(result) + "\n";
+    }
+}
+
+int exportSamples(const std::string& filename, int argc, char* argv[]) {
+    const int games = std::max(1, intOption(argc, argv, "--games", 100));
+    const SearchLimits limits(Engine::MAX_PLY, std::max(1, intOption(argc, argv, "--nodes", 5000)));
+    const int randomPlies = std::max(0, intOption(argc, argv, "--random-plies", 8));
+    const unsigned seed = static_cast<unsigned>(intOption(argc, argv, "--seed", 1));
+    const unsigned threads = std::max(1, intOption(argc, argv, "--threads",
+                                                   std::max(1u, std::thread::hardware_concurrency())));
+    std::shared_ptr<const Nnue> network = loadNetwork(stringOption(argc, argv, "--nnue"));
+
+    std::ofstream out(filename);
+    if (!out) throw std::runtime_error("Cannot write " + filename);
+    std::atomic<int> nextGame(0);
+    std::mutex outputMutex;
+    uint64_t positions = 0;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            Engine engine(1 << 16);
+            engine.setNetwork(network);
+            std::string text;
+            for (int game = nextGame++; game < games; game = nextGame++) {
+                std::mt19937 rng(seed + game);
+                text.clear();
+                exportGame(engine, limits, randomPlies, rng, text);
+                std::lock_guard<std::mutex> lock(outputMutex);
+                out << text;
+                positions += std::count(text.begin(), text.end(), '\n');
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    std::cout << "Wrote " << positions << " positions from " << games << " games to " << filename << "\n";
+    return 0;
+}
+
+void report(const char* label, std::size_t count, double seconds, long long checksum) {
+    std::cout << std::left << std::setw(20) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << count / seconds << " evals/s  " << std::setprecision(1) << std::setw(8)
+              << seconds * 1e9 / count << " ns/eval  (checksum " << checksum << ")\n";
+}
+
+int bench(int argc, char* argv[]) {
+    const int count = std::max(1, intOption(argc, argv, "--positions", 1000000));
+    std::mt19937 rng(static_cast<unsigned>(intOption(argc, argv, "--seed", 1)));
+    std::shared_ptr<const Nnue> network = loadNetwork(stringOption(argc, argv, "--nnue"));
+    if (!network) {
+        std::shared_ptr<Nnue> random = std::make_shared<Nnue>();
+        random->randomize(1);
+        network = random;
+    }
+
+    // Positions from random playouts, each with the move that follows it.
+    std::vector<Position> positions;
+    std::vector<Move> nextMoves;
+    std::vector<Move> moves;
+    while (static_cast<int>(positions.size()) < count) {
+        Position pos;
+        while (!pos.isGameOver() && static_cast<int>(positions.size()) < count) {
+            pos.generateMoves(moves);
+            Move move = moves[rng() % moves.size()];
+            positions.push_back(pos);
+            nextMoves.push_back(move);
+            pos.makeMove(move);
+        }
+    }
+    std::vector<Nnue::Accumulator> parents(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) network->refresh(positions[i], parents[i]);
+    std::cout << positions.size() << " positions, " << Nnue::instructionSet() << " inference, " << Nnue::HIDDEN
+              << "x2 accumulator\n";
+
+    Engine classic(1 << 10);
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const Position& pos : positions) checksum += classic.evaluate(pos);
+    report("classic", positions.size(), std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+           checksum);
+
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (const Position& pos : positions) checksum += network->evaluate(pos);
+    report("network refresh", positions.size(),
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), checksum);
+
+    checksum = 0;
+    Nnue::Accumulator child;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        network->update(parents[i], positions[i], nextMoves[i], child);
+        checksum += network->evaluate(child, 1 - positions[i].sideToMove());
+    }
+    report("network incremental", positions.size(),
+           std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), checksum);
+
+    // The incremental path must agree with a refresh of the child position.
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < positions.size(); i += 97) {
+        Position after = positions[i];
+        after.makeMove(nextMoves[i]);
+        network->update(parents[i], positions[i], nextMoves[i], child);
+        if (network->evaluate(child, after.sideToMove()) != network->evaluate(after)) ++mismatches;
+    }
+    if (mismatches) {
+        std::cerr << "Error: " << mismatches << " incremental updates disagree with a refresh\n";
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+    const std::string command = argv[1];
+    try {
+        if (command == "init" && argc >= 3) {
+            Nnue network;
+            network.randomize(static_cast<uint32_t>(intOption(argc, argv, "--seed", 1)));
+            network.save(argv[2]);
+            std::cout << "Wrote random network to " << argv[2] << "\n";
+        } else if (command == "export" && argc >= 3) {
+            return exportSamples(argv[2], argc, argv);
+        } else if (command == "bench") {
+            return bench(argc, argv);
+        } else {
+            usage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
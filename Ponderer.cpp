@@ -0,0 +1,39 @@
+#include "Ponderer.h"
+
+Ponderer::Ponderer(Engine& engine) : engine_(engine), stop_(false), lastHit_(false) {}
+
+Ponderer::~Ponderer() { stop(); }
+
+void Ponderer::start(const Position& position, const SearchResult& lastResult) {
+    if (thread_.joinable() || position.isGameOver()) return;
+
+    position_ = position;
+    if (lastResult.pv.size() >= 2 && position.isLegal(lastResult.pv[1])) {
+        position_.makeMove(lastResult.pv[1]);
+        if (position_.isGameOver()) position_ = position;
+    }
+
+    stop_ = false;
+    result_ = SearchResult();
+    start_ = std::chrono::steady_clock::now();
+    thread_ = std::thread([this] {
+        result_ = engine_.search(position_, SearchLimits(Engine::MAX_PLY, 0, 0, &stop_));
+    });
+}
+
+int Ponderer::stop() {
+    if (!thread_.joinable()) return -1;
+    stop_ = true;
+    thread_.join();
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+SearchResult Ponderer::search(const Position& position, int moveTimeMs) {
+    int pondered = stop();
+    lastHit_ = pondered >= 0 && position_.key() == position.key() && !result_.bestMove.isNull();
+    if (lastHit_ && pondered >= moveTimeMs) return result_;
+
+    int budget = lastHit_ ? moveTimeMs - pondered : moveTimeMs;
+    return engine_.search(position, SearchLimits(Engine::MAX_PLY, 0, budget));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "Engine.h"
+
+// Searches on the opponent's time. start() ponders the reply predicted by the last
+// search's PV, or the position itself so the table covers every reply; search() reuses
+// that work when the actual position matches and tops it up to the move time.
+class Ponderer {
+public:
+    explicit Ponderer(Engine& engine);
+    ~Ponderer();
+
+    void start(const Position& position, const SearchResult& lastResult);
+    // Returns how long pondering ran in ms, or -1 if it was not running.
+    int stop();
+    SearchResult search(const Position& position, int moveTimeMs);
+
+    bool isRunning() const { return thread_.joinable(); }
+    bool lastSearchWasHit() const { return lastHit_; }
+
+private:
+    Engine& engine_;
+    std::thread thread_;
+    std::atomic<bool> stop_;
+    Position position_;
+    SearchResult result_;
+    std::chrono::steady_clock::time_point start_;
+    bool lastHit_;
+};
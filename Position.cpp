@@ -0,0 +1,338 @@
+#include "Position.h"
+#include "Board.h"
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+struct Tables {
+    uint32_t adjacent[Position::NUM_POINTS];
+    std::vector<uint32_t> mills;
+    uint32_t millsAt[Position::NUM_POINTS][2];
+    uint64_t pieceKeys[2][Position::NUM_POINTS];
+    uint64_t handKeys[2][Position::PIECES_PER_PLAYER + 1];
+    uint64_t sideKey;
+
+    // The layout is taken from Board so both representations always agree on the rules.
+    Tables() {
+        Board board;
+        for (int pos = 0; pos < Position::NUM_POINTS; ++pos) {
+            adjacent[pos] = 0;
+            for (int adj : board.getAdjacentPositions(pos)) adjacent[pos] |= 1u << adj;
+        }
+
+        int millsFound[Position::NUM_POINTS] = {};
+        for (const auto& mill : board.getAllMills()) {
+            uint32_t mask = 0;
+            for (int pos : mill) mask |= 1u << pos;
+            mills.push_back(mask);
+            for (int pos : mill) {
+                if (millsFound[pos] == 2) throw std::runtime_error("Unsupported mill layout");
+                millsAt[pos][millsFound[pos]++] = mask;
+            }
+        }
+        for (int pos = 0; pos < Position::NUM_POINTS; ++pos) {
+            if (millsFound[pos] != 2) throw std::runtime_error("Unsupported mill layout");
+        }
+
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        auto next = [&seed]() {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        };
+        for (int color = 0; color < 2; ++color) {
+            for (int pos = 0; pos < Position::NUM_POINTS; ++pos) pieceKeys[color][pos] = next();
+            for (int count = 0; count <= Position::PIECES_PER_PLAYER; ++count) handKeys[color][count] = next();
+        }
+        sideKey = next();
+    }
+};
+
+const Tables& tables() {
+    static const Tables instance;
+    return instance;
+}
+
+bool parsePoint(const char*& text, const char* end, int& point) {
+    const char* start = text;
+    int value = 0;
+    while (text < end && *text >= '0' && *text <= '9' && text - start < 2) value = value * 10 + (*text++ - '0');
+    point = value - 1;
+    return text != start && value >= 1 && value <= Position::NUM_POINTS;
+}
+
+}
+
+uint16_t Move::pack() const {
+    return static_cast<uint16_t>((from + 1) | ((to + 1) << 5) | ((remove + 1) << 10));
+}
+
+Move Move::unpack(uint16_t packed) {
+    return Move((packed & 31) - 1, ((packed >> 5) & 31) - 1, ((packed >> 10) & 31) - 1);
+}
+
+std::string Move::toString() const {
+    if (isNull()) return "none";
+    std::string text;
+    if (!isPlacement()) text += std::to_string(from + 1) + "-";
+    text += std::to_string(to + 1);
+    if (isCapture()) text += "x" + std::to_string(remove + 1);
+    return text;
+}
+
+Move Move::fromString(const std::string& text) {
+    Move move;
+    if (!parse(text.data(), text.data() + text.size(), move)) throw std::runtime_error("Invalid move notation: " + text);
+    return move;
+}
+
+bool Move::parse(const char* begin, const char* end, Move& move) {
+    move = Move();
+    if (!parsePoint(begin, end, move.to)) return false;
+    if (begin < end && *begin == '-') {
+        move.from = move.to;
+        if (!parsePoint(++begin, end, move.to)) return false;
+    }
+    if (begin < end && *begin == 'x') {
+        if (!parsePoint(++begin, end, move.remove)) return false;
+    }
+    return begin == end;
+}
+
+const char* moveErrorMessage(MoveError error) {
+    switch (error) {
+        case MoveError::NONE: return "legal";
+        case MoveError::INVALID_POINT: return "invalid point";
+        case MoveError::WRONG_PHASE: return "wrong phase";
+        case MoveError::OCCUPIED: return "destination occupied";
+        case MoveError::NOT_OWN_PIECE: return "no own piece to move";
+        case MoveError::NOT_ADJACENT: return "destination not adjacent";
+        case MoveError::MISSING_CAPTURE: return "mill formed without capture";
+        case MoveError::UNEXPECTED_CAPTURE: return "capture without mill";
+        case MoveError::NOT_OPPONENT_PIECE: return "no opponent piece to remove";
+        case MoveError::PROTECTED_PIECE: return "removed piece is in a mill";
+    }
+    return "unknown error";
+}
+
+Position::Position() : sideToMove_(0), pliesSinceCapture_(0) {
+    occupied_[0] = occupied_[1] = 0;
+    inHand_[0] = inHand_[1] = PIECES_PER_PLAYER;
+    computeKey();
+}
+
+Position::Position(const std::vector<int>& positions, int sideToMove, int inHandLight, int inHandDark)
+    : sideToMove_(sideToMove), pliesSinceCapture_(0) {
+    if (positions.size() != NUM_POINTS) throw std::runtime_error("Invalid board state");
+    if (sideToMove != 0 && sideToMove != 1) throw std::runtime_error("Invalid side to move");
+    occupied_[0] = occupied_[1] = 0;
+    for (int pos = 0; pos < NUM_POINTS; ++pos) {
+        if (positions[pos] == 0 || positions[pos] == 1) occupied_[positions[pos]] |= 1u << pos;
+        else if (positions[pos] != -1) throw std::runtime_error("Invalid board state");
+    }
+    inHand_[0] = inHandLight;
+    inHand_[1] = inHandDark;
+    for (int color = 0; color < 2; ++color) {
+        if (inHand_[color] < 0 || inHand_[color] + piecesOnBoard(color) > PIECES_PER_PLAYER) {
+            throw std::runtime_error("Invalid number of pieces");
+        }
+    }
+    computeKey();
+}
+
+Position::Position(uint32_t light, uint32_t dark, int sideToMove, int inHandLight, int inHandDark)
+    : sideToMove_(sideToMove), pliesSinceCapture_(0) {
+    occupied_[0] = light;
+    occupied_[1] = dark;
+    inHand_[0] = inHandLight;
+    inHand_[1] = inHandDark;
+    computeKey();
+}
+
+Position Position::fromString(const std::string& text) {
+    std::istringstream in(text);
+    std::string board, side;
+    int inHandLight = -1, inHandDark = -1;
+    if (!(in >> board >> side >> inHandLight >> inHandDark) || board.size() != NUM_POINTS ||
+        (side != "O" && side != "X")) {
+        throw std::runtime_error("Invalid position: " + text);
+    }
+
+    std::vector<int> positions(NUM_POINTS, -1);
+    for (int pos = 0; pos < NUM_POINTS; ++pos) {
+        if (board[pos] == 'O') positions[pos] = 0;
+        else if (board[pos] == 'X') positions[pos] = 1;
+        else if (board[pos] != '.') throw std::runtime_error("Invalid position: " + text);
+    }
+
+    Position position(positions, side == "O" ? 0 : 1, inHandLight, inHandDark);
+    int plies = 0;
+    if (in >> plies) position.pliesSinceCapture_ = plies;
+    return position;
+}
+
+std::string Position::toString() const {
+    std::string board(NUM_POINTS, '.');
+    for (int pos = 0; pos < NUM_POINTS; ++pos) {
+        int piece = pieceAt(pos);
+        if (piece >= 0) board[pos] = piece == 0 ? 'O' : 'X';
+    }
+    return board + (sideToMove_ == 0 ? " O " : " X ") + std::to_string(inHand_[0]) + " " +
+           std::to_string(inHand_[1]) + " " + std::to_string(pliesSinceCapture_);
+}
+
+int Position::pieceAt(int pos) const {
+    uint32_t bit = 1u << pos;
+    if (occupied_[0] & bit) return 0;
+    if (occupied_[1] & bit) return 1;
+    return -1;
+}
+
+std::vector<int> Position::getPositions() const {
+    std::vector<int> positions(NUM_POINTS);
+    for (int pos = 0; pos < NUM_POINTS; ++pos) positions[pos] = pieceAt(pos);
+    return positions;
+}
+
+Position::Phase Position::phase(int color) const {
+    if (inHand_[color] > 0) return Phase::PLACING;
+    return piecesOnBoard(color) == 3 ? Phase::FLYING : Phase::MOVING;
+}
+
+uint32_t Position::removablePieces(int color) const {
+    uint32_t removable = occupied_[color] & ~millPieces(occupied_[color]);
+    return removable ? removable : occupied_[color];
+}
+
+bool Position::formsMill(uint32_t occupancy, int pos) {
+    const Tables& t = tables();
+    return (occupancy & t.millsAt[pos][0]) == t.millsAt[pos][0] ||
+           (occupancy & t.millsAt[pos][1]) == t.millsAt[pos][1];
+}
+
+uint32_t Position::millPieces(uint32_t occupancy) {
+    uint32_t pieces = 0;
+    for (uint32_t mill : tables().mills) {
+        if ((occupancy & mill) == mill) pieces |= mill;
+    }
+    return pieces;
+}
+
+uint32_t Position::adjacentMask(int pos) { return tables().adjacent[pos]; }
+int Position::millCount() { return static_cast<int>(tables().mills.size()); }
+uint32_t Position::millMask(int index) { return tables().mills[index]; }
+
+void Position::generateMoves(std::vector<Move>& moves) const {
+    moves.clear();
+    const int us = sideToMove_;
+    const uint32_t empty = emptyPoints();
+    const uint32_t removable = removablePieces(1 - us);
+
+    auto add = [&](int from, int to, uint32_t ours) {
+        if (removable && formsMill(ours, to)) {
+            for (uint32_t bits = removable; bits; bits &= bits - 1) moves.push_back(Move(from, to, lowestBit(bits)));
+        } else {
+            moves.push_back(Move(from, to));
+        }
+    };
+
+    if (inHand_[us] > 0) {
+        for (uint32_t targets = empty; targets; targets &= targets - 1) {
+            int to = lowestBit(targets);
+            add(-1, to, occupied_[us] | (1u << to));
+        }
+        return;
+    }
+
+    const bool flying = piecesOnBoard(us) == 3;
+    for (uint32_t sources = occupied_[us]; sources; sources &= sources - 1) {
+        int from = lowestBit(sources);
+        uint32_t targets = flying ? empty : (tables().adjacent[from] & empty);
+        for (; targets; targets &= targets - 1) {
+            int to = lowestBit(targets);
+            add(from, to, (occupied_[us] & ~(1u << from)) | (1u << to));
+        }
+    }
+}
+
+bool Position::hasValidMoves() const {
+    const int us = sideToMove_;
+    const uint32_t empty = emptyPoints();
+    if (inHand_[us] > 0 || piecesOnBoard(us) == 3) return empty != 0;
+    for (uint32_t sources = occupied_[us]; sources; sources &= sources - 1) {
+        if (tables().adjacent[lowestBit(sources)] & empty) return true;
+    }
+    return false;
+}
+
+// Same rules as generateMoves(), checked directly so validation never allocates.
+MoveError Position::checkMove(const Move& move) const {
+    if (move.to < 0 || move.to >= NUM_POINTS || move.from < -1 || move.from >= NUM_POINTS || move.remove < -1 ||
+        move.remove >= NUM_POINTS) {
+        return MoveError::INVALID_POINT;
+    }
+    const int us = sideToMove_;
+    const int them = 1 - us;
+    const uint32_t to = 1u << move.to;
+    if ((inHand_[us] > 0) != move.isPlacement()) return MoveError::WRONG_PHASE;
+    if (!(emptyPoints() & to)) return MoveError::OCCUPIED;
+
+    uint32_t ours = occupied_[us] | to;
+    if (!move.isPlacement()) {
+        const uint32_t from = 1u << move.from;
+        if (!(occupied_[us] & from)) return MoveError::NOT_OWN_PIECE;
+        if (piecesOnBoard(us) != 3 && !(tables().adjacent[move.from] & to)) return MoveError::NOT_ADJACENT;
+        ours &= ~from;
+    }
+
+    const uint32_t removable = formsMill(ours, move.to) ? removablePieces(them) : 0;
+    if (!removable) return move.isCapture() ? MoveError::UNEXPECTED_CAPTURE : MoveError::NONE;
+    if (!move.isCapture()) return MoveError::MISSING_CAPTURE;
+    if (!(occupied_[them] & (1u << move.remove))) return MoveError::NOT_OPPONENT_PIECE;
+    if (!(removable & (1u << move.remove))) return MoveError::PROTECTED_PIECE;
+    return MoveError::NONE;
+}
+
+bool Position::isLost() const {
+    const int us = sideToMove_;
+    return piecesOnBoard(us) + inHand_[us] < 3 || !hasValidMoves();
+}
+
+void Position::makeMove(const Move& move) {
+    const Tables& t = tables();
+    const int us = sideToMove_;
+    const int them = 1 - us;
+
+    if (move.isPlacement()) {
+        key_ ^= t.handKeys[us][inHand_[us]];
+        --inHand_[us];
+        key_ ^= t.handKeys[us][inHand_[us]];
+        pliesSinceCapture_ = 0;
+    } else {
+        occupied_[us] &= ~(1u << move.from);
+        key_ ^= t.pieceKeys[us][move.from];
+        ++pliesSinceCapture_;
+    }
+    occupied_[us] |= 1u << move.to;
+    key_ ^= t.pieceKeys[us][move.to];
+
+    if (move.isCapture()) {
+        occupied_[them] &= ~(1u << move.remove);
+        key_ ^= t.pieceKeys[them][move.remove];
+        pliesSinceCapture_ = 0;
+    }
+
+    sideToMove_ = them;
+    key_ ^= t.sideKey;
+}
+
+void Position::computeKey() {
+    const Tables& t = tables();
+    key_ = sideToMove_ ? t.sideKey : 0;
+    for (int color = 0; color < 2; ++color) {
+        for (uint32_t bits = occupied_[color]; bits; bits &= bits - 1) key_ ^= t.pieceKeys[color][lowestBit(bits)];
+        key_ ^= t.handKeys[color][inHand_[color]];
+    }
+}
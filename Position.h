@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+inline int popCount(uint32_t bits) {
+#if defined(__GNUC__)
+    return __builtin_popcount(bits);
+#else
+    int count = 0;
+    for (; bits; bits &= bits - 1) ++count;
+    return count;
+#endif
+}
+
+inline int lowestBit(uint32_t bits) {
+#if defined(__GNUC__)
+    return __builtin_ctz(bits);
+#else
+    int index = 0;
+    while (!(bits & 1u)) { bits >>= 1; ++index; }
+    return index;
+#endif
+}
+
+struct Move {
+    int from;    // -1 when placing a piece from hand
+    int to;
+    int remove;  // -1 unless the move closes a mill
+
+    Move(int from = -1, int to = -1, int remove = -1) : from(from), to(to), remove(remove) {}
+
+    bool isNull() const { return to < 0; }
+    bool isPlacement() const { return from < 0; }
+    bool isCapture() const { return remove >= 0; }
+
+    bool operator==(const Move& other) const {
+        return from == other.from && to == other.to && remove == other.remove;
+    }
+    bool operator!=(const Move& other) const { return !(*this == other); }
+
+    uint16_t pack() const;
+    static Move unpack(uint16_t packed);
+
+    // Notation uses the 1-24 numbering shown by Board::displayBoardWithReference():
+    // "7" places on 7, "7-8" moves 7 to 8 and a trailing "x3" removes the piece on 3.
+    std::string toString() const;
+    static Move fromString(const std::string& text);
+    // Non-throwing form of fromString() for hot parsing loops.
+    static bool parse(const char* begin, const char* end, Move& move);
+};
+
+// Why a move is not legal in a position, as reported by Position::checkMove().
+enum class MoveError {
+    NONE,
+    INVALID_POINT,
+    WRONG_PHASE,        // placing with an empty hand, or moving while pieces remain in hand
+    OCCUPIED,
+    NOT_OWN_PIECE,
+    NOT_ADJACENT,       // sliding too far before the player is down to three pieces
+    MISSING_CAPTURE,
+    UNEXPECTED_CAPTURE,
+    NOT_OPPONENT_PIECE,
+    PROTECTED_PIECE     // removing a piece in a mill while others are available
+};
+
+const char* moveErrorMessage(MoveError error);
+
+// Compact copy-make game state: one 24-bit occupancy mask per color plus pieces in hand.
+// Points are indexed exactly like Board::getPositions(), colors are 0 (Light) and 1 (Dark).
+class Position {
+public:
+    enum class Phase {
+        PLACING,
+        MOVING,
+        FLYING
+    };
+
+    static const int NUM_POINTS = 24;
+    static const int PIECES_PER_PLAYER = 9;
+    static const int DRAW_PLY_LIMIT = 100;
+    static const uint32_t ALL_POINTS = (1u << NUM_POINTS) - 1;
+
+    Position();
+    Position(const std::vector<int>& positions, int sideToMove, int inHandLight, int inHandDark);
+    Position(uint32_t light, uint32_t dark, int sideToMove, int inHandLight, int inHandDark);
+
+    static Position fromString(const std::string& text);
+    std::string toString() const;
+
+    int sideToMove() const { return sideToMove_; }
+    int pieceAt(int pos) const;
+    std::vector<int> getPositions() const;
+    uint32_t occupancy(int color) const { return occupied_[color]; }
+    uint32_t emptyPoints() const { return ~(occupied_[0] | occupied_[1]) & ALL_POINTS; }
+    int piecesOnBoard(int color) const { return popCount(occupied_[color]); }
+    int piecesInHand(int color) const { return inHand_[color]; }
+    int pliesSinceCapture() const { return pliesSinceCapture_; }
+    uint64_t key() const { return key_; }
+    Phase phase(int color) const;
+
+    void generateMoves(std::vector<Move>& moves) const;
+    bool hasValidMoves() const;
+    bool isLegal(const Move& move) const { return checkMove(move) == MoveError::NONE; }
+    MoveError checkMove(const Move& move) const;
+    bool isLost() const;
+    // Adjudication for search and engine matches, not a game rule: no capture for DRAW_PLY_LIMIT plies.
+    bool isDraw() const { return pliesSinceCapture_ >= DRAW_PLY_LIMIT; }
+    bool isGameOver() const { return isLost(); }
+    void makeMove(const Move& move);
+
+    uint32_t removablePieces(int color) const;
+    static bool formsMill(uint32_t occupancy, int pos);
+    static uint32_t millPieces(uint32_t occupancy);
+
+    static uint32_t adjacentMask(int pos);
+    static int millCount();
+    static uint32_t millMask(int index);
+
+private:
+    uint32_t occupied_[2];
+    int inHand_[2];
+    int sideToMove_;
+    int pliesSinceCapture_;
+    uint64_t key_;
+
+    void computeKey();
+};
@@ -0,0 +1,170 @@
+#include "PositionIndex.h"
+#include "Position.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+struct BinomialTable {
+    uint64_t values[Position::NUM_POINTS + 1][Position::NUM_POINTS + 1];
+
+    BinomialTable() {
+        for (int n = 0; n <= Position::NUM_POINTS; ++n) {
+            for (int k = 0; k <= Position::NUM_POINTS; ++k) {
+                if (k == 0) values[n][k] = 1;
+                else if (n == 0) values[n][k] = 0;
+                else values[n][k] = values[n - 1][k - 1] + values[n - 1][k];
+            }
+        }
+    }
+};
+
+const BinomialTable& binomials() {
+    static const BinomialTable table;
+    return table;
+}
+
+// Colex rank of a k-subset given as a bit mask.
+uint64_t rankSubset(uint32_t mask) {
+    const BinomialTable& table = binomials();
+    uint64_t rank = 0;
+    for (int i = 1; mask; mask &= mask - 1, ++i) rank += table.values[lowestBit(mask)][i];
+    return rank;
+}
+
+uint32_t unrankSubset(uint64_t rank, int k, int n) {
+    const BinomialTable& table = binomials();
+    uint32_t mask = 0;
+    for (int i = k, c = n - 1; i >= 1; --i) {
+        while (table.values[c][i] > rank) --c;
+        rank -= table.values[c][i];
+        mask |= 1u << c;
+        --c;
+    }
+    return mask;
+}
+
+// Moves the bits of mask that lie on free points down to consecutive indexes.
+uint32_t compress(uint32_t mask, uint32_t free) {
+    uint32_t result = 0;
+    for (int index = 0; free; free &= free - 1, ++index) {
+        if (mask & (free & (~free + 1))) result |= 1u << index;
+    }
+    return result;
+}
+
+uint32_t expand(uint32_t compact, uint32_t free) {
+    uint32_t result = 0;
+    for (int index = 0; free; free &= free - 1, ++index) {
+        if (compact & (1u << index)) result |= free & (~free + 1);
+    }
+    return result;
+}
+
+struct Subspace {
+    int light, dark, handLight, handDark, side;
+    uint64_t offset, size;
+};
+
+// Subspaces in a fixed order with prefix offsets. With Light moving first, the side
+// to move fixes how the two hand counts relate, except once Light has placed everything.
+struct StateTable {
+    std::vector<Subspace> subspaces;
+    int lookup[Position::PIECES_PER_PLAYER + 1][Position::PIECES_PER_PLAYER + 1][Position::PIECES_PER_PLAYER + 1][2][2];
+    uint64_t total;
+
+    StateTable() : total(0) {
+        std::fill(&lookup[0][0][0][0][0], &lookup[0][0][0][0][0] + sizeof(lookup) / sizeof(int), -1);
+        const int maxPieces = Position::PIECES_PER_PLAYER;
+        for (int side = 0; side < 2; ++side) {
+            for (int handLight = maxPieces; handLight >= 0; --handLight) {
+                for (int handDark = maxPieces; handDark >= 0; --handDark) {
+                    bool valid = side == 0 ? handDark == handLight
+                                           : (handDark == handLight + 1 || (handLight == 0 && handDark == 0));
+                    if (!valid) continue;
+                    for (int light = 0; light <= maxPieces - handLight; ++light) {
+                        for (int dark = 0; dark <= maxPieces - handDark; ++dark) {
+                            Subspace subspace = {light, dark, handLight, handDark, side, total,
+                                                 PositionIndex::subspaceSize(light, dark)};
+                            lookup[light][dark][handLight][handDark - handLight][side] =
+                                static_cast<int>(subspaces.size());
+                            subspaces.push_back(subspace);
+                            total += subspace.size;
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+const StateTable& states() {
+    static const StateTable table;
+    return table;
+}
+
+}
+
+namespace PositionIndex {
+
+uint64_t binomial(int n, int k) {
+    if (n < 0 || k < 0 || n > Position::NUM_POINTS || k > Position::NUM_POINTS) return 0;
+    return binomials().values[n][k];
+}
+
+uint64_t subspaceSize(int lightCount, int darkCount) {
+    return binomial(Position::NUM_POINTS, lightCount) * binomial(Position::NUM_POINTS - lightCount, darkCount);
+}
+
+uint64_t rank(uint32_t light, uint32_t dark) {
+    const int lightCount = popCount(light);
+    const int darkCount = popCount(dark);
+    const uint32_t free = ~light & Position::ALL_POINTS;
+    return rankSubset(light) * binomial(Position::NUM_POINTS - lightCount, darkCount) +
+           rankSubset(compress(dark, free));
+}
+
+uint64_t rank(const std::vector<int>& positions) {
+    if (positions.size() != Position::NUM_POINTS) throw std::runtime_error("Invalid board state");
+    uint32_t masks[2] = {0, 0};
+    for (int pos = 0; pos < Position::NUM_POINTS; ++pos) {
+        if (positions[pos] == 0 || positions[pos] == 1) masks[positions[pos]] |= 1u << pos;
+    }
+    return rank(masks[0], masks[1]);
+}
+
+void unrank(uint64_t index, int lightCount, int darkCount, uint32_t& light, uint32_t& dark) {
+    if (index >= subspaceSize(lightCount, darkCount)) throw std::out_of_range("Position index out of range");
+    const uint64_t darkSubsets = binomial(Position::NUM_POINTS - lightCount, darkCount);
+    light = unrankSubset(index / darkSubsets, lightCount, Position::NUM_POINTS);
+    dark = expand(unrankSubset(index % darkSubsets, darkCount, Position::NUM_POINTS - lightCount),
+                  ~light & Position::ALL_POINTS);
+}
+
+uint64_t stateCount() { return states().total; }
+
+uint64_t rankState(const Position& position) {
+    const StateTable& table = states();
+    const int handLight = position.piecesInHand(0);
+    const int handDark = position.piecesInHand(1);
+    int id = -1;
+    if (handDark - handLight == 0 || handDark - handLight == 1) {
+        id = table.lookup[position.piecesOnBoard(0)][position.piecesOnBoard(1)][handLight]
+                         [handDark - handLight][position.sideToMove()];
+    }
+    if (id < 0) throw std::runtime_error("Position is not a reachable state: " + position.toString());
+    return table.subspaces[id].offset + rank(position.occupancy(0), position.occupancy(1));
+}
+
+Position unrankState(uint64_t index) {
+    const StateTable& table = states();
+    if (index >= table.total) throw std::out_of_range("State index out of range");
+    auto next = std::upper_bound(table.subspaces.begin(), table.subspaces.end(), index,
+                                 [](uint64_t value, const Subspace& subspace) { return value < subspace.offset; });
+    const Subspace& subspace = *(next - 1);
+    uint32_t light, dark;
+    unrank(index - subspace.offset, subspace.light, subspace.dark, light, dark);
+    return Position(light, dark, subspace.side, subspace.handLight, subspace.handDark);
+}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class Position;
+
+// Perfect hash of a board inside the subspace with a fixed number of Light and
+// Dark pieces. Points are numbered like Board::getPositions(); the Light pieces
+// are ranked among all 24 points, the Dark pieces among the points left empty.
+namespace PositionIndex {
+
+uint64_t binomial(int n, int k);
+uint64_t subspaceSize(int lightCount, int darkCount);
+
+uint64_t rank(uint32_t light, uint32_t dark);
+uint64_t rank(const std::vector<int>& positions);
+void unrank(uint64_t index, int lightCount, int darkCount, uint32_t& light, uint32_t& dark);
+
+// Rank over every game state (board, pieces in hand, side to move) that alternating
+// placement allows; the draw counter is not part of the state.
+uint64_t stateCount();
+uint64_t rankState(const Position& position);
+Position unrankState(uint64_t index);
+
+}
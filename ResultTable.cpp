@@ -0,0 +1,214 @@
+#include "ResultTable.h"
+#include "PositionIndex.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+const char MAGIC[8] = {'N', 'M', 'M', 'T', 'B', 'L', '0', '1'};
+const uint64_t HEADER_BYTES = 8 + 4 * 4 + 8 * 2;
+
+void writeInt(std::ostream& out, uint64_t value, int bytes) {
+    char buffer[8];
+    for (int i = 0; i < bytes; ++i) buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    out.write(buffer, bytes);
+}
+
+uint64_t readInt(std::istream& in, int bytes) {
+    unsigned char buffer[8];
+    if (!in.read(reinterpret_cast<char*>(buffer), bytes)) throw std::runtime_error("Truncated result table");
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(buffer[i]) << (8 * i);
+    return value;
+}
+
+// PackBits-style coding: control byte c < 128 is followed by c + 1 literal bytes,
+// c >= 128 by one byte repeated c - 125 times (runs of 3 to 130).
+void packBits(const std::vector<uint8_t>& data, std::vector<uint8_t>& out) {
+    out.clear();
+    std::size_t i = 0;
+    while (i < data.size()) {
+        std::size_t run = 1;
+        while (i + run < data.size() && run < 130 && data[i + run] == data[i]) ++run;
+        if (run >= 3) {
+            out.push_back(static_cast<uint8_t>(run + 125));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+
+        std::size_t start = i, count = 0;
+        while (i < data.size() && count < 128) {
+            if (i + 2 < data.size() && data[i] == data[i + 1] && data[i] == data[i + 2]) break;
+            ++i;
+            ++count;
+        }
+        out.push_back(static_cast<uint8_t>(count - 1));
+        out.insert(out.end(), data.begin() + start, data.begin() + start + count);
+    }
+}
+
+void unpackBits(const std::vector<uint8_t>& in, std::size_t expected, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(expected);
+    std::size_t i = 0;
+    while (i < in.size()) {
+        uint8_t control = in[i++];
+        if (control < 128) {
+            std::size_t count = control + 1u;
+            if (i + count > in.size()) throw std::runtime_error("Corrupt result table block");
+            out.insert(out.end(), in.begin() + i, in.begin() + i + count);
+            i += count;
+        } else {
+            if (i >= in.size()) throw std::runtime_error("Corrupt result table block");
+            out.insert(out.end(), control - 125u, in[i++]);
+        }
+    }
+    if (out.size() != expected) throw std::runtime_error("Corrupt result table block");
+}
+
+}
+
+ResultTable::ResultTable(const std::string& filename, std::size_t cacheBlocks)
+    : file_(filename, std::ios::binary), cacheBlocks_(cacheBlocks ? cacheBlocks : 1), hits_(0), misses_(0) {
+    if (!file_) throw std::runtime_error("Cannot open result table " + filename);
+
+    char magic[8];
+    if (!file_.read(magic, 8) || std::memcmp(magic, MAGIC, 8) != 0) {
+        throw std::runtime_error("Not a result table: " + filename);
+    }
+    lightCount_ = static_cast<int>(readInt(file_, 4));
+    darkCount_ = static_cast<int>(readInt(file_, 4));
+    sideToMove_ = static_cast<int>(readInt(file_, 4));
+    blockPositions_ = static_cast<uint32_t>(readInt(file_, 4));
+    positionCount_ = readInt(file_, 8);
+    uint64_t blocks = readInt(file_, 8);
+
+    if (lightCount_ > Position::PIECES_PER_PLAYER || darkCount_ > Position::PIECES_PER_PLAYER ||
+        blockPositions_ == 0 || blockPositions_ % 4 != 0 ||
+        positionCount_ != PositionIndex::subspaceSize(lightCount_, darkCount_) ||
+        blocks != (positionCount_ + blockPositions_ - 1) / blockPositions_) {
+        throw std::runtime_error("Corrupt result table header: " + filename);
+    }
+
+    offsets_.resize(blocks + 1);
+    for (auto& offset : offsets_) offset = readInt(file_, 8);
+    dataStart_ = HEADER_BYTES + 8 * (blocks + 1);
+}
+
+TableResult ResultTable::probe(uint64_t index) {
+    if (index >= positionCount_) throw std::out_of_range("Position index out of range");
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::vector<uint8_t>& packed = loadBlock(index / blockPositions_);
+    uint32_t offset = static_cast<uint32_t>(index % blockPositions_);
+    return static_cast<TableResult>((packed[offset / 4] >> ((offset % 4) * 2)) & 3);
+}
+
+// Tables hold moving-phase positions only, so pieces still in hand are another game state.
+TableResult ResultTable::probe(const Position& position) {
+    if (position.piecesOnBoard(0) != lightCount_ || position.piecesOnBoard(1) != darkCount_ ||
+        position.piecesInHand(0) != 0 || position.piecesInHand(1) != 0 || position.sideToMove() != sideToMove_) {
+        return TableResult::UNKNOWN;
+    }
+    return probe(PositionIndex::rank(position.occupancy(0), position.occupancy(1)));
+}
+
+// A board has no side to move, so only the piece counts are checked against the subspace.
+TableResult ResultTable::probe(const std::vector<int>& positions) {
+    if (std::count(positions.begin(), positions.end(), 0) != lightCount_ ||
+        std::count(positions.begin(), positions.end(), 1) != darkCount_) {
+        return TableResult::UNKNOWN;
+    }
+    return probe(PositionIndex::rank(positions));
+}
+
+void ResultTable::clearCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    cached_.clear();
+    hits_ = misses_ = 0;
+}
+
+const std::vector<uint8_t>& ResultTable::loadBlock(uint64_t block) {
+    auto found = cached_.find(block);
+    if (found != cached_.end()) {
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, found->second);
+        return found->second->packed;
+    }
+    ++misses_;
+
+    if (lru_.size() >= cacheBlocks_) {
+        cached_.erase(lru_.back().block);
+        lru_.splice(lru_.begin(), lru_, std::prev(lru_.end()));
+    } else {
+        lru_.push_front(CachedBlock());
+    }
+    CachedBlock& entry = lru_.front();
+    entry.block = block;
+
+    compressed_.resize(offsets_[block + 1] - offsets_[block]);
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(dataStart_ + offsets_[block]));
+    if (!file_.read(reinterpret_cast<char*>(compressed_.data()), compressed_.size())) {
+        lru_.pop_front();
+        throw std::runtime_error("Truncated result table");
+    }
+
+    uint64_t first = block * blockPositions_;
+    uint64_t count = std::min<uint64_t>(blockPositions_, positionCount_ - first);
+    try {
+        unpackBits(compressed_, (count + 3) / 4, entry.packed);
+    } catch (...) {
+        lru_.pop_front();
+        throw;
+    }
+    cached_[block] = lru_.begin();
+    return entry.packed;
+}
+
+void ResultTable::convertRaw(const std::string& rawFile, const std::string& tableFile, int lightCount,
+                             int darkCount, int sideToMove, uint32_t blockPositions) {
+    if (blockPositions == 0 || blockPositions % 4 != 0) throw std::runtime_error("Block size must be a multiple of 4");
+    std::ifstream raw(rawFile, std::ios::binary);
+    if (!raw) throw std::runtime_error("Cannot open " + rawFile);
+    std::ofstream out(tableFile, std::ios::binary);
+    if (!out) throw std::runtime_error("Cannot write " + tableFile);
+
+    const uint64_t positions = PositionIndex::subspaceSize(lightCount, darkCount);
+    const uint64_t blocks = (positions + blockPositions - 1) / blockPositions;
+    out.write(MAGIC, 8);
+    writeInt(out, lightCount, 4);
+    writeInt(out, darkCount, 4);
+    writeInt(out, sideToMove, 4);
+    writeInt(out, blockPositions, 4);
+    writeInt(out, positions, 8);
+    writeInt(out, blocks, 8);
+    for (uint64_t i = 0; i <= blocks; ++i) writeInt(out, 0, 8);
+
+    std::vector<uint64_t> offsets(1, 0);
+    offsets.reserve(blocks + 1);
+    std::vector<char> bytes(blockPositions);
+    std::vector<uint8_t> packed, compressed;
+    for (uint64_t block = 0; block < blocks; ++block) {
+        std::size_t count = static_cast<std::size_t>(std::min<uint64_t>(blockPositions, positions - block * blockPositions));
+        if (!raw.read(bytes.data(), count)) throw std::runtime_error("Raw table is shorter than the subspace");
+
+        packed.assign((count + 3) / 4, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint8_t value = static_cast<uint8_t>(bytes[i]);
+            if (value > 3) throw std::runtime_error("Raw table value out of range");
+            packed[i / 4] |= value << ((i % 4) * 2);
+        }
+        packBits(packed, compressed);
+        out.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+        offsets.push_back(offsets.back() + compressed.size());
+    }
+    if (raw.peek() != std::char_traits<char>::eof()) throw std::runtime_error("Raw table is longer than the subspace");
+
+    out.seekp(static_cast<std::streamoff>(HEADER_BYTES));
+    for (uint64_t offset : offsets) writeInt(out, offset, 8);
+    if (!out) throw std::runtime_error("Failed writing " + tableFile);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Position.h"
+
+enum class TableResult : uint8_t {
+    DRAW = 0,
+    WIN = 1,      // for the side to move
+    LOSS = 2,
+    UNKNOWN = 3
+};
+
+// Win/draw/loss table for one (Light pieces, Dark pieces, side to move) subspace,
+// indexed by PositionIndex::rank(). Results are packed 2 bits per position into
+// fixed-size blocks, each PackBits-compressed and located through a block index.
+// A probe decodes at most one block; decoded blocks are kept in an LRU cache.
+class ResultTable {
+public:
+    static const uint32_t DEFAULT_BLOCK_POSITIONS = 4096;
+
+    explicit ResultTable(const std::string& filename, std::size_t cacheBlocks = 256);
+
+    TableResult probe(uint64_t index);
+    TableResult probe(const Position& position);
+    TableResult probe(const std::vector<int>& positions);
+
+    int lightCount() const { return lightCount_; }
+    int darkCount() const { return darkCount_; }
+    int sideToMove() const { return sideToMove_; }
+    uint64_t size() const { return positionCount_; }
+    uint64_t blockCount() const { return offsets_.size() - 1; }
+    uint32_t blockPositions() const { return blockPositions_; }
+    uint64_t compressedBytes() const { return offsets_.back(); }
+    uint64_t cacheHits() const { return hits_; }
+    uint64_t cacheMisses() const { return misses_; }
+    void clearCache();
+
+    // Raw format: one byte (a TableResult value) per index, no header.
+    static void convertRaw(const std::string& rawFile, const std::string& tableFile, int lightCount,
+                           int darkCount, int sideToMove, uint32_t blockPositions = DEFAULT_BLOCK_POSITIONS);
+
+private:
+    struct CachedBlock {
+        uint64_t block;
+        std::vector<uint8_t> packed;
+    };
+
+    std::ifstream file_;
+    int lightCount_;
+    int darkCount_;
+    int sideToMove_;
+    uint32_t blockPositions_;
+    uint64_t positionCount_;
+    uint64_t dataStart_;
+    std::vector<uint64_t> offsets_;
+
+    std::mutex mutex_;
+    std::size_t cacheBlocks_;
+    std::list<CachedBlock> lru_;
+    std::unordered_map<uint64_t, std::list<CachedBlock>::iterator> cached_;
+    std::vector<uint8_t> compressed_;
+    uint64_t hits_;
+    uint64_t misses_;
+
+    const std::vector<uint8_t>& loadBlock(uint64_t block);
+};
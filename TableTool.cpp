@@ -0,0 +1,118 @@
+#include "Position.h"
+#include "PositionIndex.h"
+#include "ResultTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* resultName(TableResult result) {
+    switch (result) {
+        case TableResult::DRAW: return "draw";
+        case TableResult::WIN:  return "win";
+        case TableResult::LOSS: return "loss";
+        default:                return "unknown";
+    }
+}
+
+int intOption(int argc, char* argv[], const std::string& name, int fallback) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (name == argv[i]) return std::atoi(argv[i + 1]);
+    }
+    return fallback;
+}
+
+void usage() {
+    std::cerr << "Usage: tabletool convert <raw> <table> --light N --dark N [--side 0|1] [--block N]\n"
+                 "       tabletool probe <table> <position>\n"
+                 "       tabletool bench <table> [--probes N] [--cache BLOCKS] [--seed N]\n";
+}
+
+// Times probes over the given indexes and prints throughput and cache behaviour.
+void timeProbes(ResultTable& table, const char* label, const std::vector<uint64_t>& indexes) {
+    uint64_t hitsBefore = table.cacheHits(), missesBefore = table.cacheMisses();
+    unsigned checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t index : indexes) checksum += static_cast<unsigned>(table.probe(index));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t hits = table.cacheHits() - hitsBefore, misses = table.cacheMisses() - missesBefore;
+    std::cout << std::left << std::setw(6) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << indexes.size() / seconds << " probes/s  " << std::setprecision(1)
+              << std::setw(8) << seconds * 1e9 / indexes.size() << " ns/probe  hit rate "
+              << std::setprecision(3) << static_cast<double>(hits) / (hits + misses) << "  (checksum "
+              << checksum << ")\n";
+}
+
+int bench(const std::string& filename, int argc, char* argv[]) {
+    const int probes = std::max(1, intOption(argc, argv, "--probes", 1000000));
+    const std::size_t cacheBlocks = std::max(1, intOption(argc, argv, "--cache", 256));
+    std::mt19937_64 rng(intOption(argc, argv, "--seed", 1));
+
+    ResultTable table(filename, cacheBlocks);
+    std::cout << table.size() << " positions (" << table.lightCount() << " Light, " << table.darkCount()
+              << " Dark), " << table.blockCount() << " blocks, " << table.compressedBytes() << " bytes compressed ("
+              << std::fixed << std::setprecision(2) << table.compressedBytes() * 4.0 / table.size()
+              << " of 2-bit size)\n";
+
+    std::vector<uint64_t> indexes(probes);
+    std::uniform_int_distribution<uint64_t> any(0, table.size() - 1);
+    for (auto& index : indexes) index = any(rng);
+    table.clearCache();
+    timeProbes(table, "cold", indexes);
+
+    // Warm: probes confined to a window of blocks that fits in the cache.
+    const uint64_t blockPositions = table.blockPositions();
+    uint64_t window = std::min<uint64_t>(table.size(), blockPositions * std::max<std::size_t>(1, cacheBlocks / 2));
+    uint64_t first = std::uniform_int_distribution<uint64_t>(0, table.size() - window)(rng);
+    std::uniform_int_distribution<uint64_t> near(first, first + window - 1);
+    for (auto& index : indexes) index = near(rng);
+    for (uint64_t index = first; index < first + window; index += blockPositions) table.probe(index);
+    timeProbes(table, "warm", indexes);
+    return 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        usage();
+        return 1;
+    }
+    const std::string command = argv[1];
+    try {
+        if (command == "convert" && argc >= 4) {
+            int light = intOption(argc, argv, "--light", -1);
+            int dark = intOption(argc, argv, "--dark", -1);
+            if (light < 0 || dark < 0 || light > Position::PIECES_PER_PLAYER || dark > Position::PIECES_PER_PLAYER) {
+                usage();
+                return 1;
+            }
+            ResultTable::convertRaw(argv[2], argv[3], light, dark, intOption(argc, argv, "--side", 0),
+                                    intOption(argc, argv, "--block", ResultTable::DEFAULT_BLOCK_POSITIONS));
+            ResultTable table(argv[3]);
+            std::cout << "Wrote " << table.size() << " positions in " << table.blockCount() << " blocks, "
+                      << table.compressedBytes() << " bytes of data\n";
+        } else if (command == "probe" && argc >= 4) {
+            ResultTable table(argv[2]);
+            std::string text;
+            for (int i = 3; i < argc; ++i) text += std::string(argv[i]) + " ";
+            std::cout << resultName(table.probe(Position::fromString(text))) << "\n";
+        } else if (command == "bench") {
+            return bench(argv[2], argc, argv);
+        } else {
+            usage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include "Engine.h"
+#include "Match.h"
+#include "Position.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Plays engine configuration A against B from balanced openings, each opening
+// twice with colors swapped, until the SPRT accepts a hypothesis or the game limit is hit.
+
+namespace {
+
+struct EngineSpec {
+    std::string text;
+    SearchLimits limits = SearchLimits(Engine::MAX_PLY, 20000);
+    EvalWeights weights;
+    std::size_t ttEntries = 1 << 18;
+    std::shared_ptr<const Nnue> network;
+};
+
+struct Options {
+    EngineSpec engines[2];
+    int maxGames = 20000;
+    unsigned concurrency = std::max(1u, std::thread::hardware_concurrency());
+    std::string openingsFile;
+    int openingPlies = 4;
+    int openingCount = 500;
+    unsigned seed = 1;
+    double elo0 = -5, elo1 = 0, alpha = 0.05, beta = 0.05;
+};
+
+struct EngineTotals {
+    uint64_t nodes = 0;
+    double thinkMs = 0;
+    int moves = 0;
+};
+
+// "depth=8,nodes=20000,time=0,tt=262144,material=100,mobility=4,openmill=12,closedmill=8,nnue=FILE"
+EngineSpec parseSpec(const std::string& text) {
+    EngineSpec spec;
+    spec.text = text;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        std::size_t eq = item.find('=');
+        if (eq == std::string::npos) throw std::runtime_error("Invalid engine option: " + item);
+        std::string key = item.substr(0, eq);
+        long long value = std::atoll(item.c_str() + eq + 1);
+        if (key == "nnue") {
+            std::shared_ptr<Nnue> network = std::make_shared<Nnue>();
+            if (!network->load(item.substr(eq + 1))) throw std::runtime_error("Cannot open " + item.substr(eq + 1));
+            spec.network = network;
+        } else if (key == "depth") spec.limits.depth = static_cast<int>(value);
+        else if (key == "nodes") spec.limits.nodes = static_cast<uint64_t>(value);
+        else if (key == "time") spec.limits.moveTimeMs = static_cast<int>(value);
+        else if (key == "tt") spec.ttEntries = static_cast<std::size_t>(value);
+        else if (key == "material") spec.weights.material = static_cast<int>(value);
+        else if (key == "mobility") spec.weights.mobility = static_cast<int>(value);
+        else if (key == "openmill") spec.weights.openMill = static_cast<int>(value);
+        else if (key == "closedmill") spec.weights.closedMill = static_cast<int>(value);
+        else throw std::runtime_error("Invalid engine option: " + item);
+    }
+    return spec;
+}
+
+std::vector<Position> loadOpenings(const std::string& filename) {
+    std::ifstream in(filename);
+    if (!in) throw std::runtime_error("Cannot open " + filename);
+    std::vector<Position> openings;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line[0] != '#') openings.push_back(Position::fromString(line));
+    }
+    return openings;
+}
+
+// Random short openings, kept only when a shallow search calls them roughly level.
+std::vector<Position> generateOpenings(int count, int plies, unsigned seed) {
+    std::mt19937 rng(seed);
+    Engine judge(1 << 16);
+    std::vector<Position> openings;
+    std::set<uint64_t> seen;
+    std::vector<Move> moves;
+    for (int attempts = 0; static_cast<int>(openings.size()) < count && attempts < count * 100; ++attempts) {
+        Position pos;
+        for (int ply = 0; ply < plies && !pos.isGameOver(); ++ply) {
+            pos.generateMoves(moves);
+            pos.makeMove(moves[rng() % moves.size()]);
+        }
+        if (pos.isGameOver() || !seen.insert(pos.key()).second) continue;
+        if (std::abs(judge.search(pos, SearchLimits(4)).score) <= 50) openings.push_back(pos);
+    }
+    return openings;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    options.engines[0] = options.engines[1] = parseSpec("depth=64,nodes=20000");
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        if (arg == "--a") options.engines[0] = parseSpec(value);
+        else if (arg == "--b") options.engines[1] = parseSpec(value);
+        else if (arg == "--games") options.maxGames = std::max(2, std::atoi(value));
+        else if (arg == "--concurrency") options.concurrency = std::max(1, std::atoi(value));
+        else if (arg == "--openings") options.openingsFile = value;
+        else if (arg == "--opening-plies") options.openingPlies = std::max(0, std::atoi(value));
+        else if (arg == "--seed") options.seed = static_cast<unsigned>(std::atoi(value));
+        else if (arg == "--elo0") options.elo0 = std::atof(value);
+        else if (arg == "--elo1") options.elo1 = std::atof(value);
+        else if (arg == "--alpha") options.alpha = std::atof(value);
+        else if (arg == "--beta") options.beta = std::atof(value);
+        else return false;
+    }
+    return true;
+}
+
+void printEngine(const char* name, const EngineSpec& spec, const EngineTotals& totals) {
+    double nps = totals.thinkMs > 0 ? totals.nodes / (totals.thinkMs / 1000.0) : 0;
+    double latency = totals.moves ? totals.thinkMs / totals.moves : 0;
+    std::cout << "Engine " << name << " [" << spec.text << "]: " << std::fixed << std::setprecision(0)
+              << nps << " nodes/s, " << std::setprecision(2) << latency << " ms/move over "
+              << totals.moves << " moves\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    std::vector<Position> openings;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            std::cerr << "Usage: tournament [--a SPEC] [--b SPEC] [--games N] [--concurrency N]\n"
+                         "                  [--openings FILE | --opening-plies N] [--seed N]\n"
+                         "                  [--elo0 E] [--elo1 E] [--alpha A] [--beta B]\n"
+                         "SPEC: depth=N,nodes=N,time=MS,tt=N,material=N,mobility=N,openmill=N,closedmill=N,nnue=FILE\n";
+            return 1;
+        }
+        openings = options.openingsFile.empty()
+                       ? generateOpenings(options.openingCount, options.openingPlies, options.seed)
+                       : loadOpenings(options.openingsFile);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    if (openings.empty()) {
+        std::cerr << "Error: no opening positions\n";
+        return 1;
+    }
+
+    const double lowerBound = std::log(options.beta / (1 - options.alpha));
+    const double upperBound = std::log((1 - options.beta) / options.alpha);
+    const int pairs = options.maxGames / 2;
+
+    std::mutex mutex;
+    MatchScore score;   // from engine A's point of view
+    EngineTotals totals[2];
+    std::atomic<int> nextPair(0);
+    std::atomic<bool> finished(false);
+    std::string verdict = "inconclusive (game limit reached)";
+
+    auto worker = [&] {
+        Engine engineA(options.engines[0].ttEntries, options.engines[0].weights);
+        Engine engineB(options.engines[1].ttEntries, options.engines[1].weights);
+        Engine* engines[2] = {&engineA, &engineB};
+        engineA.setNetwork(options.engines[0].network);
+        engineB.setNetwork(options.engines[1].network);
+        for (int pair = nextPair++; pair < pairs && !finished; pair = nextPair++) {
+            const Position& opening = openings[pair % openings.size()];
+            for (int aColor = 0; aColor < 2; ++aColor) {
+                Engine& light = *engines[aColor == 0 ? 0 : 1];
+                Engine& dark = *engines[aColor == 0 ? 1 : 0];
+                const EngineSpec& lightSpec = options.engines[aColor == 0 ? 0 : 1];
+                const EngineSpec& darkSpec = options.engines[aColor == 0 ? 1 : 0];
+                light.clear();
+                dark.clear();
+                GameRecord game = playGame(opening, light, lightSpec.limits, dark, darkSpec.limits);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (game.winner < 0) ++score.draws;
+                else if (game.winner == aColor) ++score.wins;
+                else ++score.losses;
+                for (int color = 0; color < 2; ++color) {
+                    EngineTotals& engine = totals[color == aColor ? 0 : 1];
+                    engine.nodes += game.nodes[color];
+                    engine.thinkMs += game.thinkMs[color];
+                    engine.moves += game.moveCount[color];
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            double llr = score.llr(options.elo0, options.elo1);
+            if (score.games() % 20 == 0) {
+                std::cout << "Games " << score.games() << ": +" << score.wins << " =" << score.draws << " -"
+                          << score.losses << "  LLR " << std::fixed << std::setprecision(2) << llr << " ["
+                          << lowerBound << ", " << upperBound << "]\n";
+            }
+            if (!finished && llr >= upperBound) {
+                finished = true;
+                verdict = "H1 accepted (A is not weaker than elo1)";
+            } else if (!finished && llr <= lowerBound) {
+                finished = true;
+                verdict = "H0 accepted (A is weaker, at or below elo0)";
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < options.concurrency; ++i) threads.emplace_back(worker);
+    for (auto& thread : threads) thread.join();
+
+    std::cout << "\n" << openings.size() << " openings, " << score.games() << " games, A vs B: +" << score.wins
+              << " =" << score.draws << " -" << score.losses << "\n";
+    std::cout << std::fixed << std::setprecision(1) << "Elo " << score.elo() << " +/- " << score.eloError()
+              << " (95%), score " << std::setprecision(3) << score.score() << "\n";
+    std::cout << std::setprecision(2) << "SPRT elo0=" << options.elo0 << " elo1=" << options.elo1
+              << " alpha=" << options.alpha << " beta=" << options.beta << ": LLR "
+              << score.llr(options.elo0, options.elo1) << " -> " << verdict << "\n";
+    printEngine("A", options.engines[0], totals[0]);
+    printEngine("B", options.engines[1], totals[1]);
+    return 0;
+}
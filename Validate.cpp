@@ -0,0 +1,240 @@
+#include "BoundedQueue.h"
+#include "Position.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Re-verifies server move logs: one game per line, "<game-id> <move> <move> ...",
+// each move in Move::toString() notation with an optional "P:", "M:" or "F:" prefix
+// for the phase the server recorded. The file is read in large chunks that workers
+// replay on Position without allocating per move; violations come out in input order.
+
+namespace {
+
+struct Options {
+    std::string input;
+    std::string output;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunkBytes = 1 << 20;
+    std::size_t window = 64;
+};
+
+struct Violation {
+    std::size_t line;
+    std::string game;
+    int ply;
+    std::string move;
+    std::string error;
+};
+
+struct Chunk {
+    std::size_t index = 0;
+    std::size_t firstLine = 0;
+    std::string text;
+    uint64_t games = 0;
+    uint64_t moves = 0;
+    std::vector<Violation> violations;
+};
+
+bool parsePhase(char tag, Position::Phase& phase) {
+    switch (tag) {
+        case 'P': phase = Position::Phase::PLACING; return true;
+        case 'M': phase = Position::Phase::MOVING; return true;
+        case 'F': phase = Position::Phase::FLYING; return true;
+        default: return false;
+    }
+}
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+// Replays one game and stops at its first violation, since later moves have no defined position.
+void validateGame(const char* begin, const char* end, std::size_t line, Chunk& chunk) {
+    while (begin < end && isSpace(*begin)) ++begin;
+    if (begin == end || *begin == '#') return;
+    const char* idEnd = begin;
+    while (idEnd < end && !isSpace(*idEnd)) ++idEnd;
+
+    ++chunk.games;
+    Position pos;
+    int ply = 0;
+    for (const char* token = idEnd; token < end;) {
+        while (token < end && isSpace(*token)) ++token;
+        if (token == end) break;
+        const char* tokenEnd = token;
+        while (tokenEnd < end && !isSpace(*tokenEnd)) ++tokenEnd;
+        ++ply;
+        ++chunk.moves;
+
+        const char* error = nullptr;
+        const char* text = token;
+        Position::Phase declared = Position::Phase::PLACING;
+        bool hasPhase = tokenEnd - text > 2 && text[1] == ':';
+        Move move;
+        if (hasPhase && !parsePhase(text[0], declared)) error = "invalid phase tag";
+        else if (!Move::parse(hasPhase ? text + 2 : text, tokenEnd, move)) error = "invalid notation";
+        else if (pos.isLost()) error = "move after game over";
+        else if (hasPhase && declared != pos.phase(pos.sideToMove())) error = moveErrorMessage(MoveError::WRONG_PHASE);
+        else {
+            MoveError result = pos.checkMove(move);
+            if (result != MoveError::NONE) error = moveErrorMessage(result);
+        }
+
+        if (error) {
+            chunk.violations.push_back(
+                Violation{line, std::string(begin, idEnd), ply, std::string(token, tokenEnd), error});
+            return;
+        }
+        pos.makeMove(move);
+        token = tokenEnd;
+    }
+}
+
+void validateChunk(Chunk& chunk) {
+    const char* text = chunk.text.data();
+    const char* end = text + chunk.text.size();
+    for (std::size_t line = chunk.firstLine; text < end; ++line) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(text, '\n', end - text));
+        if (!lineEnd) lineEnd = end;
+        validateGame(text, lineEnd, line, chunk);
+        text = lineEnd + 1;
+    }
+    chunk.text.clear();
+    chunk.text.shrink_to_fit();
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue) options.output = argv[++i];
+        else if (arg == "--threads" && hasValue) options.threads = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--chunk-kb" && hasValue) options.chunkBytes = std::max(1, std::atoi(argv[++i])) << 10;
+        else if (arg == "--window" && hasValue) options.window = std::max(1, std::atoi(argv[++i]));
+        else if (options.input.empty() && arg[0] != '-') options.input = arg;
+        else return false;
+    }
+    return !options.input.empty();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: validate <moves.log> [--output FILE] [--threads N] [--chunk-kb N] [--window N]\n";
+        return 1;
+    }
+
+    std::ifstream input(options.input, std::ios::binary);
+    if (!input) {
+        std::cerr << "Error: cannot open " << options.input << "\n";
+        return 1;
+    }
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Error: cannot write " << options.output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+
+    const auto start = std::chrono::steady_clock::now();
+    InFlightWindow window(options.window);
+    BoundedQueue<Chunk> read(options.window);
+    BoundedQueue<Chunk> validated(options.window);
+
+    // Chunks end on a line boundary; the partial last line is carried into the next one.
+    std::thread reader([&] {
+        std::string carry;
+        std::size_t index = 0, line = 1;
+        std::vector<char> buffer(options.chunkBytes);
+        while (input) {
+            input.read(buffer.data(), buffer.size());
+            std::size_t count = static_cast<std::size_t>(input.gcount());
+            if (count == 0) break;
+            Chunk chunk;
+            chunk.text.swap(carry);
+            chunk.text.append(buffer.data(), count);
+            std::size_t cut = chunk.text.rfind('\n');
+            if (input && cut != std::string::npos) {
+                carry.assign(chunk.text, cut + 1, std::string::npos);
+                chunk.text.resize(cut + 1);
+            } else if (input) {
+                carry.swap(chunk.text);
+                continue;
+            }
+            chunk.index = index;
+            chunk.firstLine = line;
+            line += std::count(chunk.text.begin(), chunk.text.end(), '\n');
+            window.acquire(index++);
+            read.push(std::move(chunk));
+        }
+        if (!carry.empty()) {
+            Chunk chunk;
+            chunk.index = index;
+            chunk.firstLine = line;
+            chunk.text.swap(carry);
+            window.acquire(index);
+            read.push(std::move(chunk));
+        }
+        read.close();
+    });
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < options.threads; ++i) {
+        workers.emplace_back([&] {
+            Chunk chunk;
+            while (read.pop(chunk)) {
+                validateChunk(chunk);
+                validated.push(std::move(chunk));
+            }
+        });
+    }
+
+    uint64_t games = 0, moves = 0, flagged = 0;
+    std::map<std::string, uint64_t> errorCounts;
+    std::thread writer([&] {
+        out << "game\tline\tply\tmove\terror\n";
+        std::map<std::size_t, Chunk> pending;
+        std::size_t next = 0;
+        Chunk chunk;
+        while (validated.pop(chunk)) {
+            pending.insert(std::make_pair(chunk.index, std::move(chunk)));
+            for (auto it = pending.find(next); it != pending.end(); it = pending.find(next)) {
+                for (const Violation& v : it->second.violations) {
+                    out << v.game << '\t' << v.line << '\t' << v.ply << '\t' << v.move << '\t' << v.error << '\n';
+                    ++errorCounts[v.error];
+                }
+                games += it->second.games;
+                moves += it->second.moves;
+                flagged += it->second.violations.size();
+                pending.erase(it);
+                ++next;
+                window.release();
+            }
+        }
+        out.flush();
+    });
+
+    reader.join();
+    for (auto& worker : workers) worker.join();
+    validated.close();
+    writer.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Validated " << games << " games (" << moves << " moves) in " << static_cast<long long>(seconds * 1000)
+              << " ms using " << options.threads << " threads, "
+              << static_cast<uint64_t>(seconds > 0 ? moves / seconds : 0) << " moves/s\n";
+    std::cerr << flagged << " games flagged\n";
+    for (const auto& entry : errorCounts) std::cerr << "  " << entry.first << ": " << entry.second << "\n";
+    return flagged ? 2 : 0;
+}
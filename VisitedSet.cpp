@@ -0,0 +1,88 @@
+#include "VisitedSet.h"
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#include <winioctl.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+VisitedSet::VisitedSet(const std::string& filename, uint64_t bits, bool keep)
+    : filename_(filename), bytes_((bits + 63) / 64 * 8), words_(nullptr) {
+    open(keep);
+}
+
+VisitedSet::~VisitedSet() { close(); }
+
+// Truncating the file drops every page, which is much faster than zeroing them.
+void VisitedSet::clear() {
+    close();
+    open(false);
+}
+
+#ifdef _WIN32
+
+void VisitedSet::open(bool keep) {
+    HANDLE file = CreateFileA(filename_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                              keep ? OPEN_EXISTING : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open visited set " + filename_);
+    DWORD returned = 0;
+    DeviceIoControl(file, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &returned, nullptr);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(bytes_ >> 32),
+                                        static_cast<DWORD>(bytes_), nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map visited set " + filename_);
+    }
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    words_ = static_cast<uint64_t*>(view);
+}
+
+void VisitedSet::close() {
+    if (!words_) return;
+    UnmapViewOfFile(words_);
+    CloseHandle(static_cast<HANDLE>(mappingHandle_));
+    CloseHandle(static_cast<HANDLE>(fileHandle_));
+    words_ = nullptr;
+}
+
+void VisitedSet::flush() {
+    if (!FlushViewOfFile(words_, 0) || !FlushFileBuffers(static_cast<HANDLE>(fileHandle_))) {
+        throw std::runtime_error("Cannot write visited set " + filename_);
+    }
+}
+
+#else
+
+void VisitedSet::open(bool keep) {
+    fd_ = ::open(filename_.c_str(), keep ? O_RDWR : (O_RDWR | O_CREAT | O_TRUNC), 0644);
+    if (fd_ < 0) throw std::runtime_error("Cannot open visited set " + filename_);
+    if (::ftruncate(fd_, static_cast<off_t>(bytes_)) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot size visited set " + filename_);
+    }
+    void* view = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd_);
+        throw std::runtime_error("Cannot map visited set " + filename_);
+    }
+    words_ = static_cast<uint64_t*>(view);
+}
+
+void VisitedSet::close() {
+    if (!words_) return;
+    ::munmap(words_, bytes_);
+    ::close(fd_);
+    words_ = nullptr;
+}
+
+void VisitedSet::flush() {
+    if (::msync(words_, bytes_, MS_SYNC) != 0) throw std::runtime_error("Cannot write visited set " + filename_);
+}
+
+#endif
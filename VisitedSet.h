@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Concurrent bitset over state ranks, kept in a sparse file that is mapped into
+// memory. The OS keeps it resident while it fits in RAM and pages it to disk when
+// it does not, so the same code scales from small runs to the full state space.
+class VisitedSet {
+public:
+    // Opens the existing bits in filename when keep is true, otherwise starts all clear.
+    VisitedSet(const std::string& filename, uint64_t bits, bool keep);
+    ~VisitedSet();
+    VisitedSet(const VisitedSet&) = delete;
+    VisitedSet& operator=(const VisitedSet&) = delete;
+
+    // Sets the bit and returns true if this call changed it from 0 to 1.
+    bool testAndSet(uint64_t index) {
+        uint64_t mask = 1ull << (index & 63);
+#if defined(_MSC_VER)
+        return !(_InterlockedOr64(reinterpret_cast<volatile long long*>(&words_[index >> 6]), mask) & mask);
+#else
+        return !(__atomic_fetch_or(&words_[index >> 6], mask, __ATOMIC_RELAXED) & mask);
+#endif
+    }
+
+    bool test(uint64_t index) const { return (words_[index >> 6] >> (index & 63)) & 1; }
+    uint64_t bytes() const { return bytes_; }
+
+    void clear();
+    void flush();
+
+private:
+    void open(bool keep);
+    void close();
+
+    std::string filename_;
+    uint64_t bytes_;
+    uint64_t* words_;
+#ifdef _WIN32
+    void* fileHandle_;
+    void* mappingHandle_;
+#else
+    int fd_;
+#endif
+};